@@ -0,0 +1,66 @@
+#include "harness.hpp"
+
+#include "alikhan/algo.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+using alikhan::bench::State;
+
+std::vector<std::uint64_t> make_rows(std::size_t n) {
+    std::mt19937_64 rng(7);
+    std::vector<std::uint64_t> rows(n);
+    for (auto& r : rows) r = rng();
+    return rows;
+}
+
+void sort_std(State& state) {
+    const auto rows = make_rows(1 << 20);
+    std::vector<std::uint64_t> work;
+    for (auto _ : state) {
+        (void)_;
+        work = rows;
+        std::sort(work.begin(), work.end());
+        alikhan::bench::do_not_optimize(work.data());
+    }
+    state.stop();
+    state.set_bytes_per_iter(rows.size() * sizeof(std::uint64_t));
+}
+AK_BENCH(sort_std);
+
+void sort_par(State& state) {
+    const auto rows = make_rows(1 << 20);
+    alikhan::Executor& ex = alikhan::Executor::global();
+    std::vector<std::uint64_t> work;
+    for (auto _ : state) {
+        (void)_;
+        work = rows;
+        alikhan::par_sort(ex, work.data(), work.size());
+        alikhan::bench::do_not_optimize(work.data());
+    }
+    state.stop();
+    state.set_bytes_per_iter(rows.size() * sizeof(std::uint64_t));
+}
+AK_BENCH(sort_par);
+
+void group_by_count(State& state) {
+    // 1M rows over 10k distinct keys, the shape of a terms-per-doc
+    // aggregation.
+    std::mt19937_64 rng(11);
+    std::vector<std::uint32_t> keys(1 << 20);
+    for (auto& k : keys) k = std::uint32_t(rng() % 10000);
+    alikhan::Executor& ex = alikhan::Executor::global();
+    for (auto _ : state) {
+        (void)_;
+        auto groups = alikhan::group_by(ex, keys.data(), keys.size());
+        alikhan::bench::do_not_optimize(groups.data());
+    }
+    state.stop();
+    state.set_bytes_per_iter(keys.size() * sizeof(std::uint32_t));
+}
+AK_BENCH(group_by_count);
+
+} // namespace
@@ -0,0 +1,44 @@
+#include "harness.hpp"
+
+#include "alikhan/arena.hpp"
+
+#include <cstdlib>
+
+namespace {
+
+using alikhan::Arena;
+using alikhan::bench::State;
+
+constexpr std::size_t kAllocSize = 48;   // typical parsed-record payload
+constexpr int kAllocsPerIter = 1024;
+
+void arena_alloc(State& state) {
+    Arena arena;
+    for (auto _ : state) {
+        (void)_;
+        for (int i = 0; i < kAllocsPerIter; ++i)
+            alikhan::bench::do_not_optimize(arena.allocate(kAllocSize));
+        arena.reset();
+    }
+    state.stop();
+    state.set_bytes_per_iter(kAllocSize * kAllocsPerIter);
+}
+AK_BENCH(arena_alloc);
+
+void malloc_alloc(State& state) {
+    void* ptrs[kAllocsPerIter];
+    for (auto _ : state) {
+        (void)_;
+        for (int i = 0; i < kAllocsPerIter; ++i) {
+            ptrs[i] = std::malloc(kAllocSize);
+            alikhan::bench::do_not_optimize(ptrs[i]);
+        }
+        for (int i = 0; i < kAllocsPerIter; ++i)
+            std::free(ptrs[i]);
+    }
+    state.stop();
+    state.set_bytes_per_iter(kAllocSize * kAllocsPerIter);
+}
+AK_BENCH(malloc_alloc);
+
+} // namespace
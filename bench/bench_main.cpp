@@ -0,0 +1,125 @@
+// Driver for the alikhan_bench target.
+//
+// Usage: alikhan_bench [--out FILE] [--baseline FILE] [--tolerance PCT]
+//
+// Writes one tab-separated record per benchmark to FILE (default
+// bench_output.txt, the path the repo's .gitignore reserves):
+//
+//     name<TAB>iterations<TAB>ns_per_op<TAB>mb_per_sec
+//
+// With --baseline, each ns/op is compared against the named file --
+// typically the bench_output.txt saved from an earlier commit -- and
+// the process exits 1 if any benchmark regressed by more than the
+// tolerance (default 10%), so CI can gate merges on throughput.
+
+#include "harness.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace alikhan::bench {
+
+std::vector<Registration>& registry() {
+    static std::vector<Registration> r;
+    return r;
+}
+
+std::vector<Result> run_all() {
+    std::vector<Result> out;
+    constexpr std::uint64_t kMinRunNs = 200'000'000;
+    for (const auto& reg : registry()) {
+        std::uint64_t iters = 1;
+        State st(1);
+        for (;;) {
+            st = State(iters);
+            reg.fn(st);
+            if (st.elapsed_ns() >= kMinRunNs || iters >= (1ull << 40)) break;
+            // Aim past kMinRunNs with headroom; growth is bounded so a
+            // mispredicted first probe cannot overshoot wildly.
+            std::uint64_t next = iters * 8;
+            if (st.elapsed_ns() > 0) {
+                next = iters * kMinRunNs / st.elapsed_ns() + iters / 2;
+                if (next > iters * 16) next = iters * 16;
+            }
+            iters = next > iters ? next : iters + 1;
+        }
+        Result r;
+        r.name = reg.name;
+        r.iterations = st.iterations();
+        r.ns_per_op = double(st.elapsed_ns()) / double(st.iterations());
+        r.mb_per_sec = 0;
+        if (st.bytes_per_iter() != 0 && st.elapsed_ns() != 0)
+            r.mb_per_sec = double(st.bytes_per_iter()) * st.iterations() * 1e3 /
+                           double(st.elapsed_ns());
+        out.push_back(r);
+    }
+    return out;
+}
+
+} // namespace alikhan::bench
+
+namespace {
+
+std::map<std::string, double> load_baseline(const char* path) {
+    std::map<std::string, double> base;
+    std::FILE* f = std::fopen(path, "r");
+    if (f == nullptr) return base;
+    char name[256];
+    unsigned long long iters;
+    double ns, mbs;
+    while (std::fscanf(f, "%255s %llu %lf %lf", name, &iters, &ns, &mbs) == 4)
+        base[name] = ns;
+    std::fclose(f);
+    return base;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* out_path = "bench_output.txt";
+    const char* baseline_path = nullptr;
+    double tolerance = 0.10;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            out_path = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baseline_path = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            tolerance = std::atof(argv[++i]) / 100.0;
+    }
+
+    auto results = alikhan::bench::run_all();
+
+    std::FILE* out = std::fopen(out_path, "w");
+    if (out == nullptr) {
+        std::perror(out_path);
+        return 2;
+    }
+    for (const auto& r : results) {
+        std::printf("%-40s %12llu iters %12.2f ns/op", r.name.c_str(),
+                    (unsigned long long)r.iterations, r.ns_per_op);
+        if (r.mb_per_sec > 0) std::printf(" %10.1f MB/s", r.mb_per_sec);
+        std::printf("\n");
+        std::fprintf(out, "%s\t%llu\t%.4f\t%.2f\n", r.name.c_str(),
+                     (unsigned long long)r.iterations, r.ns_per_op, r.mb_per_sec);
+    }
+    std::fclose(out);
+
+    if (baseline_path == nullptr) return 0;
+
+    auto base = load_baseline(baseline_path);
+    int regressions = 0;
+    for (const auto& r : results) {
+        auto it = base.find(r.name);
+        if (it == base.end()) continue;
+        double delta = (r.ns_per_op - it->second) / it->second;
+        if (delta > tolerance) {
+            std::printf("REGRESSION %s: %.2f -> %.2f ns/op (%+.1f%%)\n",
+                        r.name.c_str(), it->second, r.ns_per_op, delta * 100);
+            ++regressions;
+        }
+    }
+    return regressions != 0 ? 1 : 0;
+}
@@ -0,0 +1,334 @@
+// End-to-end macro-benchmark and soak driver (the alikhan_e2e target).
+//
+// The micro-benchmarks in bench/ time one subsystem at a time; this
+// suite drives the whole ingest pipeline the way production does --
+// IoEngine reads a generated corpus of README.md-like documents,
+// StreamParser tokenizes the buffers in bounded chunks, and every
+// token lands in an InvertedIndexBuilder whose snapshot is then
+// written, reopened, and queried. Several passes over the corpus make
+// it a short soak: the index keeps growing and allocator/page-cache
+// effects from earlier passes are still warm in later ones.
+//
+// Usage: alikhan_e2e [--docs N] [--passes N] [--corpus DIR] [--out FILE]
+//                    [--baseline FILE] [--tolerance PCT]
+//
+// Results go to FILE (default bench_output.txt) in the bench harness
+// record style -- name, count, gated-value, MB/s -- followed by one
+// "probe" line per alikhan::Probe with its count and p50/p90/p99/max
+// latency histogram summary. With --baseline (typically the
+// checked-in bench/e2e/baseline.txt) the process exits 1 when any
+// gated value regressed past the tolerance (default 15%), so the
+// e2e_check build target fails instead of letting the pipeline rot.
+// Peak RSS is a gated value too: memory growth is a regression here
+// just like time.
+
+#include "alikhan/index.hpp"
+#include "alikhan/io_engine.hpp"
+#include "alikhan/probe.hpp"
+#include "alikhan/stream_parser.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+AK_PROBE_DEFINE(e2e_read);
+AK_PROBE_DEFINE(e2e_parse);
+AK_PROBE_DEFINE(e2e_lookup);
+
+namespace {
+
+std::uint64_t now_ns() {
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count());
+}
+
+// --- corpus -----------------------------------------------------------
+
+// Deterministic vocabulary so every run (and the checked-in baseline)
+// indexes the same terms.
+std::vector<std::string> make_vocab(std::size_t n) {
+    std::mt19937_64 rng(42);
+    std::vector<std::string> vocab(n);
+    for (auto& w : vocab) {
+        const std::size_t len = 3 + rng() % 7;
+        w.resize(len);
+        for (auto& c : w) c = char('a' + rng() % 26);
+    }
+    return vocab;
+}
+
+// One README-ish document: a title, a few '##' sections, paragraphs
+// of vocabulary words wrapped at ~12 words per line.
+std::string make_document(std::mt19937_64& rng,
+                          const std::vector<std::string>& vocab, int id) {
+    std::string doc = "# Document " + std::to_string(id) + "\n\n";
+    const std::size_t sections = 2 + rng() % 4;
+    for (std::size_t s = 0; s < sections; ++s) {
+        doc += "## " + vocab[rng() % vocab.size()] + " " +
+               vocab[rng() % vocab.size()] + "\n\n";
+        const std::size_t words = 60 + rng() % 300;
+        for (std::size_t w = 0; w < words; ++w) {
+            doc += vocab[rng() % vocab.size()];
+            doc += (w + 1) % 12 == 0 ? '\n' : ' ';
+        }
+        doc += "\n\n";
+    }
+    return doc;
+}
+
+std::string doc_path(const std::string& dir, int id) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/doc%05d.md", id);
+    return dir + name;
+}
+
+// Writes the corpus; returns total bytes (0 on failure, errno set).
+std::size_t generate_corpus(const std::string& dir, int docs,
+                            const std::vector<std::string>& vocab) {
+    if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return 0;
+    std::mt19937_64 rng(7);
+    std::size_t total = 0;
+    for (int i = 0; i < docs; ++i) {
+        const std::string doc = make_document(rng, vocab, i);
+        std::FILE* f = std::fopen(doc_path(dir, i).c_str(), "wb");
+        if (f == nullptr) return 0;
+        const bool ok = std::fwrite(doc.data(), 1, doc.size(), f) == doc.size();
+        if (std::fclose(f) != 0 || !ok) return 0;
+        total += doc.size();
+    }
+    return total;
+}
+
+// --- pipeline ---------------------------------------------------------
+
+// Tokenizes one read buffer in 64 KiB chunks (exercising the parser's
+// cross-chunk carry the way streamed archives do) and registers the
+// document under every token.
+void index_document(alikhan::InvertedIndexBuilder& builder, std::uint32_t doc,
+                    std::string_view data) {
+    AK_PROBE_SCOPE(e2e_parse);
+    constexpr std::size_t kChunk = 64 * 1024;
+
+    alikhan::StreamParser sp;
+    std::vector<std::string> tokens;
+    alikhan::StreamParser::Event ev;
+    for (std::size_t off = 0; off < data.size(); off += kChunk) {
+        sp.feed(data.substr(off, kChunk));
+        while (sp.next(ev))
+            if (ev.type == alikhan::StreamParser::EventType::Token)
+                tokens.emplace_back(ev.text);
+    }
+    sp.finish();
+    while (sp.next(ev))
+        if (ev.type == alikhan::StreamParser::EventType::Token)
+            tokens.emplace_back(ev.text);
+
+    std::vector<std::string_view> views(tokens.begin(), tokens.end());
+    builder.add_document(doc, views.data(), views.size());
+}
+
+struct Record {
+    std::string name;
+    std::uint64_t count;
+    double value;      // the gated scalar; lower is better
+    double mb_per_sec; // 0 when not a throughput record
+};
+
+std::uint64_t peak_rss_kb() {
+    struct rusage ru;
+    if (::getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+    return std::uint64_t(ru.ru_maxrss);
+}
+
+// Baseline files are previous --out output; probe lines and anything
+// else unparsable is skipped, mirroring the bench_main loader.
+bool load_baseline(const char* path,
+                   std::vector<std::pair<std::string, double>>& out) {
+    std::FILE* f = std::fopen(path, "r");
+    if (f == nullptr) return false;
+    char line[512];
+    while (std::fgets(line, sizeof(line), f) != nullptr) {
+        char name[256];
+        unsigned long long count;
+        double value;
+        if (std::sscanf(line, "%255s %llu %lf", name, &count, &value) == 3 &&
+            std::strncmp(name, "probe", 5) != 0)
+            out.emplace_back(name, value);
+    }
+    std::fclose(f);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int docs = 2000;
+    int passes = 3;
+    std::string corpus_dir = "e2e_corpus";
+    const char* out_path = "bench_output.txt";
+    const char* baseline_path = nullptr;
+    double tolerance = 0.15;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--docs") == 0 && i + 1 < argc)
+            docs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc)
+            passes = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--corpus") == 0 && i + 1 < argc)
+            corpus_dir = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            out_path = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baseline_path = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            tolerance = std::atof(argv[++i]) / 100.0;
+    }
+    if (docs < 1 || passes < 1) return 2;
+
+    const auto vocab = make_vocab(4096);
+    const std::size_t corpus_bytes = generate_corpus(corpus_dir, docs, vocab);
+    if (corpus_bytes == 0) {
+        std::perror(corpus_dir.c_str());
+        return 2;
+    }
+
+    std::vector<Record> records;
+
+    // Ingest: every pass reads the whole corpus through IoEngine's
+    // adaptive path and feeds the parser from the completion callback,
+    // exactly the production shape.
+    alikhan::InvertedIndexBuilder builder;
+    std::uint32_t next_doc = 0;
+    std::size_t read_errors = 0;
+    const std::uint64_t ingest_start = now_ns();
+    for (int pass = 0; pass < passes; ++pass) {
+        alikhan::IoEngine::Options opts;
+        opts.adaptive = true;
+        alikhan::IoEngine engine(opts);
+        for (int i = 0; i < docs; ++i)
+            engine.submit_read(
+                doc_path(corpus_dir, i),
+                [&](const std::string&, std::string_view data, int error) {
+                    AK_PROBE_SCOPE(e2e_read);
+                    if (error != 0) {
+                        ++read_errors;
+                        return;
+                    }
+                    index_document(builder, next_doc++, data);
+                });
+        engine.run();
+    }
+    const std::uint64_t ingest_ns = now_ns() - ingest_start;
+    if (read_errors != 0) {
+        std::fprintf(stderr, "e2e: %zu reads failed\n", read_errors);
+        return 2;
+    }
+    const std::uint64_t total_docs = std::uint64_t(docs) * passes;
+    records.push_back({"e2e_ingest", total_docs,
+                       double(ingest_ns) / double(total_docs),
+                       double(corpus_bytes) * passes * 1e3 / double(ingest_ns)});
+
+    // Snapshot: serialize, then reopen the mapped form.
+    const std::string snap_path = corpus_dir + "/e2e.idx";
+    const std::uint64_t snap_start = now_ns();
+    if (!builder.write(snap_path.c_str())) {
+        std::perror(snap_path.c_str());
+        return 2;
+    }
+    alikhan::InvertedIndex index;
+    if (!index.open(snap_path.c_str())) {
+        std::perror(snap_path.c_str());
+        return 2;
+    }
+    const std::uint64_t snap_ns = now_ns() - snap_start;
+    struct stat st;
+    const double snap_mb_s =
+        ::stat(snap_path.c_str(), &st) == 0
+            ? double(st.st_size) * 1e3 / double(snap_ns)
+            : 0;
+    records.push_back({"e2e_snapshot", 1, double(snap_ns), snap_mb_s});
+
+    // Query: decode full posting lists for a deterministic sample of
+    // vocabulary terms (hits and misses both count -- production sees
+    // both).
+    constexpr std::uint64_t kLookups = 20000;
+    std::mt19937_64 qrng(13);
+    std::vector<std::uint32_t> postings;
+    std::uint64_t matched = 0;
+    const std::uint64_t query_start = now_ns();
+    for (std::uint64_t q = 0; q < kLookups; ++q) {
+        AK_PROBE_SCOPE(e2e_lookup);
+        const std::uint32_t t = index.find_term(vocab[qrng() % vocab.size()]);
+        if (t == alikhan::InvertedIndex::kNoTerm) continue;
+        const auto p = index.postings(t);
+        postings.resize(p.doc_count);
+        matched += index.decode_postings(p, postings.data());
+    }
+    const std::uint64_t query_ns = now_ns() - query_start;
+    if (matched == 0) {
+        std::fprintf(stderr, "e2e: no query matched the index\n");
+        return 2;
+    }
+    records.push_back({"e2e_query", kLookups,
+                       double(query_ns) / double(kLookups), 0});
+
+    records.push_back({"e2e_peak_rss_kb", 1, double(peak_rss_kb()), 0});
+
+    // Report, bench harness style plus one histogram line per probe.
+    std::FILE* out = std::fopen(out_path, "w");
+    if (out == nullptr) {
+        std::perror(out_path);
+        return 2;
+    }
+    for (const auto& r : records) {
+        std::printf("%-24s %12llu %14.2f", r.name.c_str(),
+                    (unsigned long long)r.count, r.value);
+        if (r.mb_per_sec > 0) std::printf(" %10.1f MB/s", r.mb_per_sec);
+        std::printf("\n");
+        std::fprintf(out, "%s\t%llu\t%.4f\t%.2f\n", r.name.c_str(),
+                     (unsigned long long)r.count, r.value, r.mb_per_sec);
+    }
+    for (const alikhan::Probe* p = alikhan::Probe::first(); p != nullptr;
+         p = p->next()) {
+        std::printf("probe %-18s %12llu p50=%lluns p90=%lluns p99=%lluns "
+                    "max=%lluns\n",
+                    p->name(), (unsigned long long)p->count(),
+                    (unsigned long long)p->quantile_ns(0.50),
+                    (unsigned long long)p->quantile_ns(0.90),
+                    (unsigned long long)p->quantile_ns(0.99),
+                    (unsigned long long)p->max_ns());
+        std::fprintf(out, "probe\t%s\t%llu\t%llu\t%llu\t%llu\t%llu\n",
+                     p->name(), (unsigned long long)p->count(),
+                     (unsigned long long)p->quantile_ns(0.50),
+                     (unsigned long long)p->quantile_ns(0.90),
+                     (unsigned long long)p->quantile_ns(0.99),
+                     (unsigned long long)p->max_ns());
+    }
+    std::fclose(out);
+
+    if (baseline_path == nullptr) return 0;
+
+    std::vector<std::pair<std::string, double>> base;
+    if (!load_baseline(baseline_path, base)) {
+        std::perror(baseline_path);
+        return 2;
+    }
+    int regressions = 0;
+    for (const auto& r : records)
+        for (const auto& [name, value] : base) {
+            if (name != r.name || value <= 0) continue;
+            const double delta = (r.value - value) / value;
+            if (delta > tolerance) {
+                std::printf("REGRESSION %s: %.2f -> %.2f (%+.1f%%)\n",
+                            r.name.c_str(), value, r.value, delta * 100);
+                ++regressions;
+            }
+        }
+    return regressions != 0 ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// Minimal Google-Benchmark-style harness for the alikhan_bench target.
+//
+// Benchmarks are free functions taking a bench::State; register them
+// with AK_BENCH(fn). The runner auto-scales iteration counts until each
+// benchmark runs for ~kMinRunNs, then emits one tab-separated record
+// per benchmark (name, iterations, ns/op, MB/s) both to stdout and to
+// bench_output.txt so results are machine-readable per commit. See
+// bench_main.cpp for the baseline-comparison driver.
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace alikhan::bench {
+
+class State {
+public:
+    explicit State(std::uint64_t iters) : left_(iters), iters_(iters) {}
+
+    // for (auto _ : state) { ... }  -- the timed region.
+    struct iterator {
+        State* s;
+        bool operator!=(const iterator&) const { return s->left_ != 0; }
+        void operator++() { --s->left_; }
+        int operator*() const { return 0; }
+    };
+    iterator begin() {
+        start_ = std::chrono::steady_clock::now();
+        return {this};
+    }
+    iterator end() { return {this}; }
+
+    void stop() {
+        elapsed_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start_)
+                          .count();
+    }
+
+    // Declares how many payload bytes one iteration processed; the
+    // runner turns this into MB/s.
+    void set_bytes_per_iter(std::uint64_t b) { bytes_per_iter_ = b; }
+
+    std::uint64_t iterations() const { return iters_; }
+    std::uint64_t elapsed_ns() const { return elapsed_ns_; }
+    std::uint64_t bytes_per_iter() const { return bytes_per_iter_; }
+
+private:
+    std::uint64_t left_;
+    std::uint64_t iters_;
+    std::uint64_t bytes_per_iter_ = 0;
+    std::uint64_t elapsed_ns_ = 0;
+    std::chrono::steady_clock::time_point start_{};
+};
+
+using BenchFn = void (*)(State&);
+
+struct Registration {
+    const char* name;
+    BenchFn fn;
+};
+
+std::vector<Registration>& registry();
+
+struct Registrar {
+    Registrar(const char* name, BenchFn fn) { registry().push_back({name, fn}); }
+};
+
+// Prevents the optimizer from deleting a benchmarked computation.
+template <typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    double ns_per_op;
+    double mb_per_sec;   // 0 when the benchmark declared no bytes
+};
+
+// Runs every registered benchmark and returns one Result each.
+std::vector<Result> run_all();
+
+} // namespace alikhan::bench
+
+#define AK_BENCH(fn) \
+    static ::alikhan::bench::Registrar ak_bench_reg_##fn(#fn, fn)
@@ -0,0 +1,71 @@
+#include "harness.hpp"
+
+#include "alikhan/hash.hpp"
+
+#include <functional>
+#include <string>
+
+namespace {
+
+using alikhan::bench::State;
+
+std::string make_buffer(std::size_t size) {
+    std::string s(size, '\0');
+    std::uint64_t x = 0x12345678;
+    for (auto& c : s) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        c = char(x >> 56);
+    }
+    return s;
+}
+
+void fast_hash_64k(State& state) {
+    const std::string buf = make_buffer(64 * 1024);
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(alikhan::fast_hash(buf));
+    }
+    state.stop();
+    state.set_bytes_per_iter(buf.size());
+}
+AK_BENCH(fast_hash_64k);
+
+void fast_hash_small(State& state) {
+    const std::string buf = make_buffer(24);   // token-sized key
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(alikhan::fast_hash(buf));
+    }
+    state.stop();
+    state.set_bytes_per_iter(buf.size());
+}
+AK_BENCH(fast_hash_small);
+
+void std_hash_64k(State& state) {
+    const std::string buf = make_buffer(64 * 1024);
+    const std::hash<std::string_view> h;
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(h(buf));
+    }
+    state.stop();
+    state.set_bytes_per_iter(buf.size());
+}
+AK_BENCH(std_hash_64k);
+
+void streaming_hash_64k(State& state) {
+    const std::string buf = make_buffer(64 * 1024);
+    for (auto _ : state) {
+        (void)_;
+        alikhan::StreamingHash h;
+        // Fed in StreamParser-sized chunks.
+        for (std::size_t p = 0; p < buf.size(); p += 4096)
+            h.update(std::string_view(buf).substr(p, 4096));
+        alikhan::bench::do_not_optimize(h.digest64());
+    }
+    state.stop();
+    state.set_bytes_per_iter(buf.size());
+}
+AK_BENCH(streaming_hash_64k);
+
+} // namespace
@@ -0,0 +1,63 @@
+#include "harness.hpp"
+
+#include "alikhan/mpmc_queue.hpp"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using alikhan::MpmcQueue;
+using alikhan::bench::State;
+
+constexpr int kOpsPerIter = 1024;
+
+void mpmc_spsc_throughput(State& state) {
+    MpmcQueue<std::uint64_t> q(4096);
+    std::atomic<bool> stop{false};
+    std::thread consumer([&] {
+        std::uint64_t v;
+        while (!stop.load(std::memory_order_relaxed))
+            while (q.try_pop(v)) alikhan::bench::do_not_optimize(v);
+    });
+    for (auto _ : state) {
+        (void)_;
+        for (int i = 0; i < kOpsPerIter; ++i)
+            while (!q.try_push(std::uint64_t(i))) {}
+    }
+    state.stop();
+    stop.store(true);
+    consumer.join();
+    state.set_bytes_per_iter(kOpsPerIter * sizeof(std::uint64_t));
+}
+AK_BENCH(mpmc_spsc_throughput);
+
+void mutex_deque_throughput(State& state) {
+    std::deque<std::uint64_t> q;
+    std::mutex mu;
+    std::atomic<bool> stop{false};
+    std::thread consumer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mu);
+            while (!q.empty()) {
+                alikhan::bench::do_not_optimize(q.front());
+                q.pop_front();
+            }
+        }
+    });
+    for (auto _ : state) {
+        (void)_;
+        for (int i = 0; i < kOpsPerIter; ++i) {
+            std::lock_guard<std::mutex> lock(mu);
+            q.push_back(std::uint64_t(i));
+        }
+    }
+    state.stop();
+    stop.store(true);
+    consumer.join();
+    state.set_bytes_per_iter(kOpsPerIter * sizeof(std::uint64_t));
+}
+AK_BENCH(mutex_deque_throughput);
+
+} // namespace
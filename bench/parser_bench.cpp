@@ -0,0 +1,45 @@
+#include "harness.hpp"
+
+#include "alikhan/arena.hpp"
+#include "alikhan/parser.hpp"
+
+#include <string>
+
+namespace {
+
+using alikhan::bench::State;
+
+// A few hundred README-shaped resumes concatenated: heading-delimited
+// sections of objective-statement prose.
+std::string make_corpus() {
+    std::string doc;
+    for (int i = 0; i < 400; ++i) {
+        doc += "# alikhan\n";
+        doc +=
+            "To obtain a position in an organization that provides an "
+            "environment to enhance my knowledge and skills. Seeking to "
+            "leverage the organization's success utilizing my experience, "
+            "technical expertise, and problem-solving skills.\n";
+        doc += "## Skills\n";
+        doc += "C++ SIMD concurrency profiling linux databases\n";
+        doc += "## Contact\n";
+        doc += "someone@example.com +1-555-0100\n";
+    }
+    return doc;
+}
+
+void resume_parse(State& state) {
+    const std::string corpus = make_corpus();
+    alikhan::Arena arena(1 << 20);
+    alikhan::ResumeParser parser(arena);
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(parser.parse(corpus));
+        arena.reset();
+    }
+    state.stop();
+    state.set_bytes_per_iter(corpus.size());
+}
+AK_BENCH(resume_parse);
+
+} // namespace
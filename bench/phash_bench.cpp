@@ -0,0 +1,63 @@
+#include "harness.hpp"
+
+#include "alikhan/phash.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using alikhan::bench::State;
+
+// The matcher vocabulary: section names plus the README objective
+// statement's terms.
+constexpr std::string_view kKeywords[] = {
+    "experience", "skills",      "education",  "objective",   "summary",
+    "contact",    "projects",    "position",   "organization", "environment",
+    "knowledge",  "leverage",    "success",    "technical",   "expertise",
+    "problem-solving",           "obtain",     "provides",    "enhance",
+    "seeking",    "utilizing",   "references", "certifications",
+};
+constexpr auto kTable = alikhan::make_perfect_hash(kKeywords);
+
+// Half hits, half misses, like a real token stream.
+std::vector<std::string> make_probes() {
+    std::vector<std::string> probes;
+    for (auto k : kKeywords) probes.emplace_back(k);
+    for (auto k : kKeywords) probes.emplace_back(std::string(k) + "x");
+    return probes;
+}
+
+void phash_lookup(State& state) {
+    const auto probes = make_probes();
+    std::size_t hits = 0;
+    for (auto _ : state) {
+        (void)_;
+        for (const auto& p : probes)
+            hits += kTable.contains(p);
+    }
+    state.stop();
+    alikhan::bench::do_not_optimize(hits);
+    state.set_bytes_per_iter(probes.size());
+}
+AK_BENCH(phash_lookup);
+
+void unordered_map_lookup(State& state) {
+    std::unordered_map<std::string_view, std::uint32_t> map;
+    for (std::uint32_t i = 0; i < std::size(kKeywords); ++i)
+        map.emplace(kKeywords[i], i);
+    const auto probes = make_probes();
+    std::size_t hits = 0;
+    for (auto _ : state) {
+        (void)_;
+        for (const auto& p : probes)
+            hits += map.count(p);
+    }
+    state.stop();
+    alikhan::bench::do_not_optimize(hits);
+    state.set_bytes_per_iter(probes.size());
+}
+AK_BENCH(unordered_map_lookup);
+
+} // namespace
@@ -0,0 +1,58 @@
+#include "harness.hpp"
+
+#include "alikhan/simd_find.hpp"
+
+#include <string>
+
+namespace {
+
+using alikhan::bench::State;
+
+// README-like prose: common letters, needle appears once near the end.
+std::string make_haystack(std::size_t size, std::string_view needle) {
+    static constexpr std::string_view kFiller =
+        "To obtain a position in an organization that provides an "
+        "environment to enhance my knowledge and skills. ";
+    std::string h;
+    while (h.size() < size - needle.size())
+        h.append(kFiller.substr(0, size - needle.size() - h.size()));
+    h.append(needle);
+    return h;
+}
+
+constexpr std::string_view kNeedle = "problem-solving";
+
+void simd_find(State& state) {
+    const std::string hay = make_haystack(64 * 1024, kNeedle);
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(alikhan::find(hay, kNeedle));
+    }
+    state.stop();
+    state.set_bytes_per_iter(hay.size());
+}
+AK_BENCH(simd_find);
+
+void stdstring_find(State& state) {
+    const std::string hay = make_haystack(64 * 1024, kNeedle);
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(hay.find(kNeedle));
+    }
+    state.stop();
+    state.set_bytes_per_iter(hay.size());
+}
+AK_BENCH(stdstring_find);
+
+void simd_find_first_of(State& state) {
+    const std::string hay = make_haystack(64 * 1024, "@#");
+    for (auto _ : state) {
+        (void)_;
+        alikhan::bench::do_not_optimize(alikhan::find_first_of(hay, "@#"));
+    }
+    state.stop();
+    state.set_bytes_per_iter(hay.size());
+}
+AK_BENCH(simd_find_first_of);
+
+} // namespace
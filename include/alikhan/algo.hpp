@@ -0,0 +1,279 @@
+#pragma once
+
+// Parallel sort and group-by kernels for columnar buffers.
+//
+// par_sort() is a sample sort on the work-stealing Executor: it picks
+// splitters from an oversampled subset, classifies rows into
+// cache-sized buckets with one parallel counting pass and one
+// parallel scatter, then sorts each bucket independently. Buckets are
+// sized so a bucket's rows fit in L2, which keeps the per-bucket
+// std::sort out of DRAM; the two linear passes are the only full
+// sweeps of the input.
+//
+// group_by() aggregates a key column (optionally summing a value
+// column) with per-chunk open-addressing tables that are merged once
+// at the end, so workers never contend on a shared map. Results are
+// returned sorted by key for deterministic output.
+//
+// Both kernels operate on raw columnar arrays -- the layout
+// ColumnView::data<T>() exposes -- and require trivially copyable
+// element types, which every ColumnFile column type satisfies.
+
+#include "alikhan/executor.hpp"
+#include "alikhan/hash.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace alikhan {
+
+namespace algo_detail {
+
+template <typename T>
+std::uint64_t hash_key(const T& key) noexcept {
+    return fast_hash(
+        std::string_view(reinterpret_cast<const char*>(&key), sizeof(T)));
+}
+
+// Open-addressing map from key to an aggregate payload A. A slot is
+// occupied iff its aggregate's count is nonzero, so no separate
+// occupancy bits are needed.
+template <typename K, typename A>
+class FlatAgg {
+public:
+    void upsert(const K& key, const A& delta) {
+        if (entries_.empty()) rehash(1024);
+        else if ((size_ + 1) * 2 > entries_.size()) rehash(entries_.size() * 2);
+        Entry& e = probe(entries_, key);
+        if (e.agg.count == 0) {
+            e.key = key;
+            ++size_;
+        }
+        e.agg.combine(delta);
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const Entry& e : entries_)
+            if (e.agg.count != 0) fn(e.key, e.agg);
+    }
+
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    struct Entry {
+        K key;
+        A agg{};    // count == 0 marks the slot empty
+    };
+
+    static Entry& probe(std::vector<Entry>& entries, const K& key) {
+        const std::size_t mask = entries.size() - 1;
+        std::size_t i = hash_key(key) & mask;
+        while (entries[i].agg.count != 0 &&
+               std::memcmp(&entries[i].key, &key, sizeof(K)) != 0)
+            i = (i + 1) & mask;
+        return entries[i];
+    }
+
+    void rehash(std::size_t new_cap) {
+        std::vector<Entry> fresh(new_cap);
+        for (const Entry& e : entries_)
+            if (e.agg.count != 0) probe(fresh, e.key) = e;
+        entries_.swap(fresh);
+    }
+
+    std::vector<Entry> entries_;
+    std::size_t size_ = 0;
+};
+
+struct CountAgg {
+    std::uint64_t count = 0;
+    void combine(const CountAgg& o) noexcept { count += o.count; }
+};
+
+template <typename V>
+struct SumAgg {
+    std::uint64_t count = 0;
+    V sum{};
+    void combine(const SumAgg& o) noexcept {
+        count += o.count;
+        sum += o.sum;
+    }
+};
+
+// Shared two-phase driver: per-chunk local tables built in parallel,
+// merged once, emitted sorted by key.
+template <typename K, typename A, typename Row, typename Load>
+std::vector<Row> grouped(Executor& ex, const K* keys, std::size_t n,
+                         const Load& load) {
+    const std::size_t nchunks =
+        n < (1u << 14) ? 1 : std::size_t(ex.worker_count()) * 4;
+    const std::size_t grain = (n + nchunks - 1) / nchunks;
+    std::vector<FlatAgg<K, A>> locals(nchunks);
+    ex.parallel_for(0, nchunks, 1, [&](std::size_t cb, std::size_t ce) {
+        for (std::size_t c = cb; c < ce; ++c) {
+            const std::size_t lo = c * grain;
+            const std::size_t hi = std::min(n, lo + grain);
+            for (std::size_t i = lo; i < hi; ++i)
+                locals[c].upsert(keys[i], load(i));
+        }
+    });
+
+    FlatAgg<K, A> merged = std::move(locals[0]);
+    for (std::size_t c = 1; c < nchunks; ++c)
+        locals[c].for_each(
+            [&](const K& k, const A& a) { merged.upsert(k, a); });
+
+    std::vector<Row> rows;
+    rows.reserve(merged.size());
+    merged.for_each([&](const K& k, const A& a) {
+        rows.push_back(Row{k, a});
+    });
+    std::sort(rows.begin(), rows.end(),
+              [](const Row& a, const Row& b) { return a.key < b.key; });
+    return rows;
+}
+
+} // namespace algo_detail
+
+// Sorts data[0, n) in place using every worker of `ex`. Equivalent to
+// std::sort(data, data + n, cmp) but partitioned into L2-sized
+// buckets that sort concurrently. Falls back to serial std::sort for
+// small inputs.
+template <typename T, typename Compare = std::less<T>>
+void par_sort(Executor& ex, T* data, std::size_t n, Compare cmp = {}) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "par_sort operates on columnar (trivially copyable) rows");
+    if (n < (1u << 14) || ex.worker_count() < 2) {
+        std::sort(data, data + n, cmp);
+        return;
+    }
+
+    // Bucket count: enough for every worker, small enough that an
+    // average bucket (~256 KiB) stays cache-resident while it sorts.
+    std::size_t nbuckets = (n * sizeof(T)) >> 18;
+    nbuckets = std::max<std::size_t>(nbuckets, ex.worker_count());
+    nbuckets = std::min<std::size_t>(nbuckets, 512);
+
+    // Splitters from a 16x oversample, taken at even strides.
+    const std::size_t oversample = 16;
+    const std::size_t nsample = nbuckets * oversample;
+    std::vector<T> sample;
+    sample.reserve(nsample);
+    for (std::size_t i = 0; i < nsample; ++i)
+        sample.push_back(data[i * (n / nsample)]);
+    std::sort(sample.begin(), sample.end(), cmp);
+    std::vector<T> splitters;
+    splitters.reserve(nbuckets - 1);
+    for (std::size_t b = 1; b < nbuckets; ++b)
+        splitters.push_back(sample[b * oversample - 1]);
+
+    const auto bucket_of = [&](const T& v) {
+        return std::size_t(
+            std::upper_bound(splitters.begin(), splitters.end(), v, cmp) -
+            splitters.begin());
+    };
+
+    const std::size_t nchunks = std::size_t(ex.worker_count()) * 4;
+    const std::size_t grain = (n + nchunks - 1) / nchunks;
+
+    // Pass 1: per-chunk bucket histograms.
+    std::vector<std::size_t> counts(nchunks * nbuckets, 0);
+    ex.parallel_for(0, nchunks, 1, [&](std::size_t cb, std::size_t ce) {
+        for (std::size_t c = cb; c < ce; ++c) {
+            std::size_t* row = &counts[c * nbuckets];
+            const std::size_t lo = c * grain;
+            const std::size_t hi = std::min(n, lo + grain);
+            for (std::size_t i = lo; i < hi; ++i) ++row[bucket_of(data[i])];
+        }
+    });
+
+    // Exclusive prefix over (bucket, chunk) gives each chunk a
+    // private write cursor per bucket.
+    std::vector<std::size_t> cursor(nchunks * nbuckets);
+    std::vector<std::size_t> bucket_start(nbuckets + 1);
+    std::size_t running = 0;
+    for (std::size_t b = 0; b < nbuckets; ++b) {
+        bucket_start[b] = running;
+        for (std::size_t c = 0; c < nchunks; ++c) {
+            cursor[c * nbuckets + b] = running;
+            running += counts[c * nbuckets + b];
+        }
+    }
+    bucket_start[nbuckets] = running;
+
+    // Pass 2: scatter into bucket order in a scratch buffer.
+    std::vector<T> tmp(n);
+    ex.parallel_for(0, nchunks, 1, [&](std::size_t cb, std::size_t ce) {
+        for (std::size_t c = cb; c < ce; ++c) {
+            std::size_t* row = &cursor[c * nbuckets];
+            const std::size_t lo = c * grain;
+            const std::size_t hi = std::min(n, lo + grain);
+            for (std::size_t i = lo; i < hi; ++i)
+                tmp[row[bucket_of(data[i])]++] = data[i];
+        }
+    });
+
+    // Pass 3: sort each bucket and copy it back to its final range.
+    ex.parallel_for(0, nbuckets, 1, [&](std::size_t bb, std::size_t be) {
+        for (std::size_t b = bb; b < be; ++b) {
+            const std::size_t lo = bucket_start[b];
+            const std::size_t hi = bucket_start[b + 1];
+            std::sort(tmp.data() + lo, tmp.data() + hi, cmp);
+            std::memcpy(data + lo, tmp.data() + lo, (hi - lo) * sizeof(T));
+        }
+    });
+}
+
+template <typename K>
+struct GroupCount {
+    K key;
+    std::uint64_t count = 0;
+
+    GroupCount() = default;
+    GroupCount(const K& k, const algo_detail::CountAgg& a)
+        : key(k), count(a.count) {}
+};
+
+template <typename K, typename V>
+struct GroupSum {
+    K key;
+    std::uint64_t count = 0;
+    V sum{};
+
+    GroupSum() = default;
+    GroupSum(const K& k, const algo_detail::SumAgg<V>& a)
+        : key(k), count(a.count), sum(a.sum) {}
+};
+
+// Counts occurrences of each distinct key in keys[0, n). Rows come
+// back sorted by key.
+template <typename K>
+std::vector<GroupCount<K>> group_by(Executor& ex, const K* keys,
+                                    std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<K>,
+                  "group_by keys must be columnar (trivially copyable)");
+    using algo_detail::CountAgg;
+    return algo_detail::grouped<K, CountAgg, GroupCount<K>>(
+        ex, keys, n, [](std::size_t) { return CountAgg{1}; });
+}
+
+// Counts and sums values[i] per distinct keys[i]. Rows come back
+// sorted by key.
+template <typename K, typename V>
+std::vector<GroupSum<K, V>> group_by(Executor& ex, const K* keys,
+                                     const V* values, std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<K> &&
+                      std::is_trivially_copyable_v<V>,
+                  "group_by columns must be columnar (trivially copyable)");
+    using Agg = algo_detail::SumAgg<V>;
+    return algo_detail::grouped<K, Agg, GroupSum<K, V>>(
+        ex, keys, n, [&](std::size_t i) { return Agg{1, values[i]}; });
+}
+
+} // namespace alikhan
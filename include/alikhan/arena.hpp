@@ -0,0 +1,130 @@
+#pragma once
+
+// alikhan::Arena -- bump-pointer region allocator.
+//
+// The arena owns a chain of geometrically growing blocks and hands out
+// raw storage by advancing a cursor; individual allocations are never
+// freed, the whole region is released at once by reset() or the
+// destructor. This is the allocation strategy for every hot path in the
+// library: allocate() is a pointer bump in the common case and the only
+// time we touch the system allocator is when a block fills up.
+//
+// Arena is not thread-safe; give each worker its own arena (or a
+// per-thread shard) instead of sharing one behind a lock.
+//
+// Arenas that back multi-gigabyte working sets can opt into huge
+// pages: blocks of 2 MiB and up are then reserved with mmap --
+// MAP_HUGETLB when the pool has pages, otherwise a 2 MiB-aligned
+// anonymous mapping under MADV_HUGEPAGE -- which cuts dTLB misses in
+// scans over arena-resident data. Small blocks stay on the ordinary
+// allocator either way.
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace alikhan {
+
+class Arena {
+public:
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+    static constexpr std::size_t kHugePageSize = std::size_t{2} * 1024 * 1024;
+
+    enum class HugePages {
+        Off,          // every block from the system allocator
+        Transparent,  // 2 MiB-aligned mmap + MADV_HUGEPAGE
+        Explicit,     // MAP_HUGETLB, falling back to Transparent
+    };
+
+    explicit Arena(std::size_t block_size = kDefaultBlockSize,
+                   HugePages huge = HugePages::Off) noexcept
+        : block_size_(block_size), huge_(huge) {}
+
+    ~Arena() { release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&& other) noexcept
+        : head_(other.head_), cur_(other.cur_), end_(other.end_),
+          block_size_(other.block_size_), huge_(other.huge_),
+          bytes_used_(other.bytes_used_) {
+        other.head_ = nullptr;
+        other.cur_ = other.end_ = nullptr;
+        other.bytes_used_ = 0;
+    }
+
+    Arena& operator=(Arena&& other) noexcept {
+        if (this != &other) {
+            release();
+            head_ = other.head_;
+            cur_ = other.cur_;
+            end_ = other.end_;
+            block_size_ = other.block_size_;
+            huge_ = other.huge_;
+            bytes_used_ = other.bytes_used_;
+            other.head_ = nullptr;
+            other.cur_ = other.end_ = nullptr;
+            other.bytes_used_ = 0;
+        }
+        return *this;
+    }
+
+    // Returns storage of at least `size` bytes aligned to `align`
+    // (a power of two). Never returns nullptr; block refill throws
+    // std::bad_alloc like the global allocator it replaces.
+    void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+        std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(cur_) + (align - 1)) & ~(align - 1);
+        if (p + size <= reinterpret_cast<std::uintptr_t>(end_)) [[likely]] {
+            cur_ = reinterpret_cast<char*>(p + size);
+            bytes_used_ += size;
+            return reinterpret_cast<void*>(p);
+        }
+        return allocate_slow(size, align);
+    }
+
+    // Constructs a T in arena storage. The destructor is never run;
+    // only put trivially destructible types (or types whose cleanup
+    // you do not care about) in an arena.
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Copies `len` bytes into the arena and returns the copy.
+    char* dup(const char* data, std::size_t len) {
+        char* p = static_cast<char*>(allocate(len, 1));
+        for (std::size_t i = 0; i < len; ++i) p[i] = data[i];
+        return p;
+    }
+
+    // Rewinds the arena to empty, keeping the first block for reuse so
+    // a steady-state reset()/refill loop does not touch malloc at all.
+    void reset() noexcept;
+
+    std::size_t bytes_used() const noexcept { return bytes_used_; }
+    std::size_t block_size() const noexcept { return block_size_; }
+
+private:
+    struct Block {
+        Block* next;
+        std::size_t size;      // usable bytes following the header
+        std::size_t map_len;   // mmap length; 0 = operator new block
+        alignas(std::max_align_t) char data[1];
+    };
+
+    void* allocate_slow(std::size_t size, std::size_t align);
+    Block* new_block(std::size_t min_size);
+    static void free_block(Block* b) noexcept;
+    void release() noexcept;
+
+    Block* head_ = nullptr;       // most recently carved block
+    char* cur_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t block_size_;
+    HugePages huge_ = HugePages::Off;
+    std::size_t bytes_used_ = 0;
+};
+
+} // namespace alikhan
@@ -0,0 +1,236 @@
+#pragma once
+
+// alikhan::ShardedCache<K, V> -- fixed-capacity concurrent LRU cache.
+//
+// Keys are routed to one of S shards by hash; each shard is an
+// independent LRU protected by its own spinlock, so the contention
+// surface under concurrent get/put is 1/S of a single-lock cache.
+// Within a shard the design is allocation-free after construction:
+// entries live in a fixed slab threaded onto an index-based LRU list,
+// and an open-addressing slot table (tombstone deletion, periodic
+// in-place rebuild) maps keys to slab indices. put() on a full shard
+// evicts that shard's least-recently-used entry.
+//
+// Intended use: parse results keyed by content hash, so dedup-heavy
+// workloads skip the re-parse entirely. V is returned by copy under
+// the shard lock -- keep it cheap (a pointer, an id, a small struct).
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace alikhan {
+
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ShardedCache {
+public:
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+    };
+
+    explicit ShardedCache(std::size_t capacity, unsigned shard_count = 16) {
+        if (shard_count == 0) shard_count = 1;
+        std::size_t per_shard = (capacity + shard_count - 1) / shard_count;
+        if (per_shard == 0) per_shard = 1;
+        shards_.reserve(shard_count);
+        for (unsigned i = 0; i < shard_count; ++i)
+            shards_.push_back(std::make_unique<Shard>(per_shard));
+    }
+
+    // Copies the cached value into `out` and marks the entry most
+    // recently used. False on miss.
+    bool get(const K& key, V& out) {
+        const std::size_t h = Hash{}(key);
+        Shard& s = shard_for(h);
+        SpinGuard guard(s.lock);
+        const std::uint32_t e = s.find(key, h);
+        if (e == kNil) {
+            ++s.stats.misses;
+            return false;
+        }
+        s.touch(e);
+        out = s.entries[e].value;
+        ++s.stats.hits;
+        return true;
+    }
+
+    // Inserts or overwrites; evicts the shard's LRU entry when full.
+    void put(const K& key, V value) {
+        const std::size_t h = Hash{}(key);
+        Shard& s = shard_for(h);
+        SpinGuard guard(s.lock);
+        const std::uint32_t existing = s.find(key, h);
+        if (existing != kNil) {
+            s.entries[existing].value = std::move(value);
+            s.touch(existing);
+            return;
+        }
+        s.insert(key, std::move(value), h);
+    }
+
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (const auto& s : shards_) n += s->used;
+        return n;
+    }
+
+    Stats stats() const {
+        Stats total;
+        for (const auto& s : shards_) {
+            SpinGuard guard(s->lock);
+            total.hits += s->stats.hits;
+            total.misses += s->stats.misses;
+            total.evictions += s->stats.evictions;
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr std::uint32_t kSlotEmpty = 0xFFFFFFFFu;
+    static constexpr std::uint32_t kSlotTomb = 0xFFFFFFFEu;
+
+    struct Spinlock {
+        mutable std::atomic_flag flag = ATOMIC_FLAG_INIT;
+        void lock() const noexcept {
+            while (flag.test_and_set(std::memory_order_acquire))
+                while (flag.test(std::memory_order_relaxed)) {}
+        }
+        void unlock() const noexcept { flag.clear(std::memory_order_release); }
+    };
+
+    struct SpinGuard {
+        const Spinlock& l;
+        explicit SpinGuard(const Spinlock& lk) : l(lk) { l.lock(); }
+        ~SpinGuard() { l.unlock(); }
+    };
+
+    struct Entry {
+        K key;
+        V value;
+        std::size_t hash = 0;
+        std::uint32_t prev = kNil;   // LRU links (head = most recent)
+        std::uint32_t next = kNil;
+    };
+
+    struct Shard {
+        explicit Shard(std::size_t capacity)
+            : entries(capacity), slot_mask(table_size(capacity) - 1),
+              slots(table_size(capacity), kSlotEmpty) {}
+
+        static std::size_t table_size(std::size_t capacity) {
+            std::size_t p = 8;
+            while (p < capacity * 2) p *= 2;
+            return p;
+        }
+
+        std::uint32_t find(const K& key, std::size_t h) const {
+            std::size_t i = h & slot_mask;
+            for (;;) {
+                const std::uint32_t s = slots[i];
+                if (s == kSlotEmpty) return kNil;
+                if (s != kSlotTomb && entries[s].hash == h &&
+                    entries[s].key == key)
+                    return s;
+                i = (i + 1) & slot_mask;
+            }
+        }
+
+        void touch(std::uint32_t e) {
+            if (lru_head == e) return;
+            unlink(e);
+            entries[e].prev = kNil;
+            entries[e].next = lru_head;
+            if (lru_head != kNil) entries[lru_head].prev = e;
+            lru_head = e;
+            if (lru_tail == kNil) lru_tail = e;
+        }
+
+        void unlink(std::uint32_t e) {
+            if (entries[e].prev != kNil) entries[entries[e].prev].next = entries[e].next;
+            if (entries[e].next != kNil) entries[entries[e].next].prev = entries[e].prev;
+            if (lru_head == e) lru_head = entries[e].next;
+            if (lru_tail == e) lru_tail = entries[e].prev;
+            entries[e].prev = entries[e].next = kNil;
+        }
+
+        void erase_slot(std::size_t h, std::uint32_t e) {
+            std::size_t i = h & slot_mask;
+            while (slots[i] != e) i = (i + 1) & slot_mask;
+            slots[i] = kSlotTomb;
+            ++tombstones;
+        }
+
+        void insert(const K& key, V&& value, std::size_t h) {
+            // Rebuild before claiming a slab slot so the new entry is
+            // inserted exactly once.
+            if (tombstones > slots.size() / 4) rebuild();
+            std::uint32_t e;
+            if (used < entries.size()) {
+                e = std::uint32_t(used++);
+            } else {
+                // Evict the LRU tail and reuse its slab slot.
+                e = lru_tail;
+                unlink(e);
+                erase_slot(entries[e].hash, e);
+                ++stats.evictions;
+            }
+            entries[e].key = key;
+            entries[e].value = std::move(value);
+            entries[e].hash = h;
+            entries[e].prev = entries[e].next = kNil;
+            touch_new(e);
+
+            std::size_t i = h & slot_mask;
+            while (slots[i] < kSlotTomb) i = (i + 1) & slot_mask;
+            if (slots[i] == kSlotTomb) --tombstones;
+            slots[i] = e;
+        }
+
+        void touch_new(std::uint32_t e) {
+            entries[e].next = lru_head;
+            if (lru_head != kNil) entries[lru_head].prev = e;
+            lru_head = e;
+            if (lru_tail == kNil) lru_tail = e;
+        }
+
+        // Reinserts every live entry into a cleared slot table,
+        // dropping accumulated tombstones. In-place, no allocation.
+        void rebuild() {
+            for (auto& s : slots) s = kSlotEmpty;
+            tombstones = 0;
+            for (std::uint32_t e = 0; e < used; ++e) {
+                std::size_t i = entries[e].hash & slot_mask;
+                while (slots[i] < kSlotTomb) i = (i + 1) & slot_mask;
+                slots[i] = e;
+            }
+        }
+
+        Spinlock lock;
+        std::vector<Entry> entries;      // fixed slab
+        std::size_t slot_mask;
+        std::vector<std::uint32_t> slots;
+        std::size_t used = 0;
+        std::size_t tombstones = 0;
+        std::uint32_t lru_head = kNil;
+        std::uint32_t lru_tail = kNil;
+        Stats stats;
+    };
+
+    Shard& shard_for(std::size_t h) {
+        // Remix before picking the shard: std::hash is identity for
+        // integers on common implementations, and the slot table
+        // already consumes the low bits.
+        std::uint64_t x = std::uint64_t(h) * 0x9E3779B97F4A7C15ull;
+        return *shards_[(x >> 56) % shards_.size()];
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace alikhan
@@ -0,0 +1,97 @@
+#pragma once
+
+// Per-column compression codecs for ColumnFile sections.
+//
+// Two codecs cover the shapes resume extracts actually have:
+//
+//   * Frame-of-reference (ColumnCodec::FrameOfRef) for integer
+//     columns: values are split into 1024-row blocks, each block
+//     stores its minimum plus the deltas bit-packed at the block's
+//     own width. Monotone ids and clustered counts pack to a few
+//     bits per row.
+//
+//   * Dictionary (ColumnCodec::Dict) for Bytes columns: distinct
+//     spellings are interned once (an InternPool assigns the ids)
+//     and rows become bit-packed dictionary ids. Job titles and
+//     skill names -- a few thousand spellings across millions of
+//     rows -- collapse to the dictionary plus ~2 bytes a row.
+//
+// Encoding is the cold write path and appends to the writer's byte
+// buffer. Decoding fills caller-provided buffers -- blocks unpack
+// with AVX2 widening loads where the width allows -- and per-row
+// accessors (ColumnView::get_u64/get_bytes) read single values
+// straight out of the mapping, so point lookups stay zero-copy.
+//
+// Layouts, all little-endian and 8-byte aligned:
+//
+//   FrameOfRef: [u32 nblocks][u32 pad][u32 block_off[nblocks + 1]]
+//               [pad to 8] then per block
+//               [u64 reference][u8 bits][pad 7][packed u64 words]
+//   Dict:       [u32 dict_count][u32 id_bits]
+//               [u32 dict_off[dict_count + 1]][spelling blob]
+//               [pad to 8][packed id words]
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace alikhan {
+namespace codec {
+
+// Rows per frame-of-reference block; block deltas are sized so an
+// unpacked block (8 KiB) stays in L1 while it is narrowed or scanned.
+inline constexpr std::size_t kForBlock = 1024;
+
+// Appends the encoded column to `out`.
+void for_encode_u64(const std::uint64_t* values, std::size_t n,
+                    std::vector<char>& out);
+void for_encode_u32(const std::uint32_t* values, std::size_t n,
+                    std::vector<char>& out);
+
+// Decodes a full column of `n` rows into `out`. Returns false when
+// the encoded bytes are inconsistent with `n`/`size`.
+bool for_decode_u64(const void* data, std::size_t size, std::size_t n,
+                    std::uint64_t* out) noexcept;
+bool for_decode_u32(const void* data, std::size_t size, std::size_t n,
+                    std::uint32_t* out) noexcept;
+
+// Random access into an encoded column; `data` must have passed
+// for_decode validation or come from a writer (no bounds checks).
+std::uint64_t for_get(const void* data, std::size_t row) noexcept;
+
+// Appends the dictionary-encoded rows to `out`.
+void dict_encode(const std::string_view* values, std::size_t n,
+                 std::vector<char>& out);
+
+// Cheap cursor over a dictionary-encoded section; all views alias
+// the encoded bytes.
+class DictView {
+public:
+    // Validates the header against `size`; false on inconsistency.
+    bool init(const void* data, std::size_t size, std::size_t rows) noexcept;
+
+    std::uint32_t dict_count() const noexcept { return dict_count_; }
+    std::string_view entry(std::uint32_t id) const noexcept {
+        return {blob_ + dict_off_[id], dict_off_[id + 1] - dict_off_[id]};
+    }
+
+    std::uint32_t id_at(std::size_t row) const noexcept;
+    std::string_view at(std::size_t row) const noexcept {
+        return entry(id_at(row));
+    }
+
+    // Unpacks every row's id into `out` (rows entries).
+    void decode_ids(std::uint32_t* out) const noexcept;
+
+private:
+    const std::uint32_t* dict_off_ = nullptr;
+    const char* blob_ = nullptr;
+    const std::uint64_t* words_ = nullptr;
+    std::size_t rows_ = 0;
+    std::uint32_t dict_count_ = 0;
+    std::uint32_t id_bits_ = 0;
+};
+
+} // namespace codec
+} // namespace alikhan
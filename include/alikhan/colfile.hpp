@@ -0,0 +1,225 @@
+#pragma once
+
+// alikhan::ColumnFile -- memory-mappable columnar output format.
+//
+// Replaces flat-text result dumps (the old test_output.txt style) with
+// a binary layout downstream analytics can scan one field at a time:
+//
+//   [FileHeader][column data sections ...][ColumnDesc table]
+//
+// Fixed-width columns (u32/u64/f64) are raw little-endian arrays;
+// Bytes columns are a u32 offset array (row_count + 1 entries) followed
+// by one concatenated blob, so row i is blob[off[i], off[i+1]). Every
+// section is 64-byte aligned. Each ColumnDesc carries a codec id:
+// codec 0 is uncompressed, integer columns can opt into
+// frame-of-reference bit packing and Bytes columns into dictionary
+// encoding (see codec.hpp for the section layouts). Point accessors
+// work on any codec; bulk scans of encoded columns decode into a
+// caller-provided buffer.
+//
+// open() validates the header and descriptor table only -- O(1)
+// regardless of file size -- and serves all row data zero-copy out of
+// the mapping. Writing is the cold path and buffers in ordinary
+// containers.
+
+#include "alikhan/codec.hpp"
+#include "alikhan/mmap_io.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alikhan {
+
+enum class ColumnType : std::uint16_t {
+    U32 = 0,
+    U64 = 1,
+    F64 = 2,
+    Bytes = 3,
+};
+
+enum class ColumnCodec : std::uint16_t {
+    Raw = 0,
+    Dict = 1,          // Bytes: bit-packed dictionary ids
+    FrameOfRef = 2,    // U32/U64: per-block reference + packed deltas
+};
+
+namespace colfile_detail {
+
+constexpr char kMagic[4] = {'A', 'K', 'C', 'F'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kSectionAlign = 64;
+constexpr std::size_t kHugeSectionAlign = std::size_t{2} * 1024 * 1024;
+constexpr std::size_t kMaxNameLen = 31;
+
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t column_count;
+    std::uint32_t reserved;
+    std::uint64_t row_count;
+    std::uint64_t desc_offset;   // byte offset of the ColumnDesc table
+};
+static_assert(sizeof(FileHeader) == 32);
+
+struct ColumnDesc {
+    char name[kMaxNameLen + 1];  // NUL-terminated
+    std::uint16_t type;
+    std::uint16_t codec;
+    std::uint32_t reserved;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    std::uint64_t aux_offset;    // Bytes columns: the offset array
+    std::uint64_t aux_size;
+};
+static_assert(sizeof(ColumnDesc) == 72);
+
+} // namespace colfile_detail
+
+// Read-only view of one column inside an open ColumnFile. Cheap to
+// copy; valid while the owning ColumnFile stays open.
+class ColumnView {
+public:
+    ColumnView() = default;
+
+    bool valid() const noexcept { return desc_ != nullptr; }
+    std::string_view name() const noexcept { return desc_->name; }
+    ColumnType type() const noexcept { return ColumnType(desc_->type); }
+    ColumnCodec codec() const noexcept { return ColumnCodec(desc_->codec); }
+    std::uint64_t row_count() const noexcept { return rows_; }
+
+    // Raw pointer to the fixed-width payload; element count is
+    // row_count(). Only meaningful for U32/U64/F64 Raw columns.
+    template <typename T>
+    const T* data() const noexcept {
+        return reinterpret_cast<const T*>(base_ + desc_->data_offset);
+    }
+
+    std::uint64_t get_u64(std::uint64_t row) const noexcept {
+        if (codec() == ColumnCodec::FrameOfRef)
+            return codec::for_get(base_ + desc_->data_offset, row);
+        return type() == ColumnType::U32 ? data<std::uint32_t>()[row]
+                                         : data<std::uint64_t>()[row];
+    }
+
+    double get_f64(std::uint64_t row) const noexcept {
+        return data<double>()[row];
+    }
+
+    std::string_view get_bytes(std::uint64_t row) const noexcept {
+        if (codec() == ColumnCodec::Dict) return dict_bytes(row);
+        const auto* off =
+            reinterpret_cast<const std::uint32_t*>(base_ + desc_->aux_offset);
+        return {base_ + desc_->data_offset + off[row], off[row + 1] - off[row]};
+    }
+
+    // Bulk decode into a caller buffer of row_count() entries; true
+    // for Raw and FrameOfRef columns of the matching width.
+    bool decode_u64(std::uint64_t* out) const noexcept;
+    bool decode_u32(std::uint32_t* out) const noexcept;
+
+    // Binds `out` to a Dict column's dictionary and packed ids; false
+    // for other codecs.
+    bool dict(codec::DictView& out) const noexcept;
+
+private:
+    friend class ColumnFile;
+    ColumnView(const char* base, const colfile_detail::ColumnDesc* desc,
+               std::uint64_t rows) noexcept
+        : base_(base), desc_(desc), rows_(rows) {}
+
+    std::string_view dict_bytes(std::uint64_t row) const noexcept;
+
+    const char* base_ = nullptr;
+    const colfile_detail::ColumnDesc* desc_ = nullptr;
+    std::uint64_t rows_ = 0;
+};
+
+class ColumnFile {
+public:
+    // Maps `path` and validates header + descriptor table. Returns
+    // false (errno or format error) without touching row data.
+    bool open(const char* path) noexcept;
+
+    // Serves an already-resident serialized file -- a shared-memory
+    // snapshot slot, typically. The bytes must outlive the ColumnFile
+    // and stay immutable while it is open.
+    bool open_bytes(const char* data, std::size_t size) noexcept;
+
+    void close() noexcept {
+        map_.close();
+        base_ = nullptr;
+        header_ = nullptr;
+        descs_ = nullptr;
+    }
+
+    bool is_open() const noexcept { return header_ != nullptr; }
+    std::uint32_t column_count() const noexcept { return header_->column_count; }
+    std::uint64_t row_count() const noexcept { return header_->row_count; }
+
+    ColumnView column(std::uint32_t index) const noexcept {
+        return {base_, &descs_[index], header_->row_count};
+    }
+
+    // Lookup by name; returns an invalid view when absent.
+    ColumnView column(std::string_view name) const noexcept;
+
+    const MappedFile& mapping() const noexcept { return map_; }
+
+private:
+    bool bind(const char* data, std::size_t size) noexcept;
+
+    MappedFile map_;
+    const char* base_ = nullptr;
+    const colfile_detail::FileHeader* header_ = nullptr;
+    const colfile_detail::ColumnDesc* descs_ = nullptr;
+};
+
+// Buffers columns in memory and serializes them with aligned sections.
+// All columns must have the same row count by write() time.
+// Integer columns accept ColumnCodec::FrameOfRef and Bytes columns
+// ColumnCodec::Dict; a codec the column type does not support falls
+// back to Raw.
+class ColumnFileWriter {
+public:
+    void add_u32(std::string_view name, const std::uint32_t* values,
+                 std::size_t n, ColumnCodec codec = ColumnCodec::Raw);
+    void add_u64(std::string_view name, const std::uint64_t* values,
+                 std::size_t n, ColumnCodec codec = ColumnCodec::Raw);
+    void add_f64(std::string_view name, const double* values, std::size_t n);
+    void add_bytes(std::string_view name, const std::string_view* values,
+                   std::size_t n, ColumnCodec codec = ColumnCodec::Raw);
+
+    // Pads every section to `align` instead of the 64-byte default.
+    // Multi-gigabyte snapshots pass kHugeSectionAlign so the mapped
+    // sections are 2 MiB-aligned and THP-eligible (the reader spots
+    // the layout and advises the kernel); the padding makes it a poor
+    // fit for small files. Ignored unless `align` is a power of two
+    // of at least the default.
+    void set_section_align(std::size_t align) noexcept {
+        if (align >= colfile_detail::kSectionAlign &&
+            (align & (align - 1)) == 0)
+            section_align_ = align;
+    }
+
+    // Writes the file; returns false on I/O error or if column row
+    // counts disagree (errno EINVAL).
+    bool write(const char* path) const noexcept;
+
+private:
+    struct PendingColumn {
+        std::string name;
+        ColumnType type;
+        ColumnCodec codec = ColumnCodec::Raw;
+        std::vector<char> data;
+        std::vector<std::uint32_t> offsets;   // raw Bytes columns only
+        std::uint64_t rows = 0;
+    };
+
+    std::vector<PendingColumn> columns_;
+    std::size_t section_align_ = colfile_detail::kSectionAlign;
+};
+
+} // namespace alikhan
@@ -0,0 +1,88 @@
+#pragma once
+
+// alikhan::Executor -- work-stealing thread pool.
+//
+// Each worker owns an MpmcQueue of tasks; submit() from a worker
+// thread pushes to that worker's own queue (cheap, cache-warm) and an
+// idle worker that drains its queue steals from the others before
+// parking. parallel_for() carves an index range into grain-sized
+// chunks claimed from a shared atomic cursor, so loop bodies never
+// heap-allocate per item and load-balance automatically when chunk
+// costs are skewed.
+//
+// Worker count defaults to hardware_concurrency(). The destructor
+// drains outstanding work and joins all workers.
+
+#include "alikhan/mpmc_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace alikhan {
+
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+    struct Options {
+        unsigned threads = 0;        // 0 = hardware_concurrency
+        bool pin_to_nodes = false;   // pin workers round-robin across
+                                     // NUMA nodes; steals then prefer
+                                     // same-node victims
+    };
+
+    explicit Executor(unsigned threads = 0);
+    explicit Executor(const Options& opts);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    // Enqueues `task` for execution on some worker. Safe from any
+    // thread, including from inside a running task.
+    void submit(Task task);
+
+    // Runs fn(begin, end) over grain-sized sub-ranges of [begin, end)
+    // across all workers; the calling thread participates. Returns
+    // when every chunk has finished. `fn` must be safe to invoke
+    // concurrently on disjoint ranges.
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                      const std::function<void(std::size_t, std::size_t)>& fn);
+
+    unsigned worker_count() const noexcept { return unsigned(workers_.size()); }
+
+    // Process-wide default pool, constructed on first use.
+    static Executor& global();
+
+private:
+    struct WorkerState {
+        explicit WorkerState(std::size_t cap) : queue(cap) {}
+        MpmcQueue<Task> queue;
+    };
+
+    void build_steal_orders();
+    void worker_loop(unsigned index);
+    bool try_run_one(unsigned self);
+    void push_task(Task&& task);
+    void wake_one();
+
+    std::vector<std::unique_ptr<WorkerState>> queues_;
+    // steal_order_[w] lists every worker starting with w itself, then
+    // same-NUMA-node peers, then the rest; try_run_one walks it.
+    std::vector<std::vector<unsigned>> steal_order_;
+    std::vector<std::thread> workers_;
+    std::mutex park_mu_;
+    std::condition_variable park_cv_;
+    std::atomic<std::uint64_t> pending_{0};
+    std::atomic<unsigned> next_queue_{0};
+    std::atomic<bool> stopping_{false};
+    Options opts_;
+};
+
+} // namespace alikhan
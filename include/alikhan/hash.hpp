@@ -0,0 +1,55 @@
+#pragma once
+
+// alikhan::fast_hash -- vectorized content hashing, the canonical key
+// function for the cache and intern pool.
+//
+// xxHash3-style construction: input is consumed in 64-byte blocks as
+// eight 64-bit lanes, each xored with a fixed secret and folded with
+// a 32x32->64 multiply. The block loop dispatches at first call to an
+// AVX2 kernel (vpmuludq, matching simd_find's dispatcher style) with
+// a scalar kernel that computes bit-identical results everywhere
+// else; the final partial block is always processed scalar
+// (zero-padded), so digests are stable across ISAs and between the
+// one-shot and streaming forms.
+//
+// StreamingHash carries only the eight accumulators plus at most one
+// buffered block, sized for feeding StreamParser chunks as they
+// arrive; its digest equals fast_hash over the concatenated input.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace alikhan {
+
+struct Hash128 {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+    friend bool operator==(const Hash128&, const Hash128&) = default;
+};
+
+std::uint64_t fast_hash(std::string_view data, std::uint64_t seed = 0) noexcept;
+Hash128 fast_hash128(std::string_view data, std::uint64_t seed = 0) noexcept;
+
+class StreamingHash {
+public:
+    explicit StreamingHash(std::uint64_t seed = 0) noexcept { reset(seed); }
+
+    void reset(std::uint64_t seed = 0) noexcept;
+    void update(std::string_view data) noexcept;
+
+    // Digest of everything fed so far; update() may continue after.
+    std::uint64_t digest64() const noexcept;
+    Hash128 digest128() const noexcept;
+
+    std::uint64_t bytes_consumed() const noexcept { return total_; }
+
+private:
+    std::uint64_t acc_[8];
+    std::uint64_t seed_ = 0;
+    std::uint64_t total_ = 0;
+    unsigned char buf_[64];
+    unsigned buffered_ = 0;
+};
+
+} // namespace alikhan
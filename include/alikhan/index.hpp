@@ -0,0 +1,217 @@
+#pragma once
+
+// alikhan::InvertedIndex -- term -> document posting lists with
+// SIMD-decoded compression.
+//
+// Posting lists are stored delta-encoded in StreamVByte form: a
+// control stream of 2-bit length codes (1..4 bytes per value) and a
+// data stream of the value bytes. Decode is a table-driven pshufb
+// loop on x86 (four values per shuffle) with a scalar fallback, so a
+// query touches only the postings it intersects and unpacks them at
+// memory speed.
+//
+// The on-disk form is a regular ColumnFile ("terms" and "postings"
+// Bytes columns plus a "doc_counts" U32 column, terms sorted), so the
+// snapshot is memory-mapped with O(1) open and the same tooling that
+// reads analytics outputs can inspect an index. Building is the cold
+// path and uses ordinary containers.
+
+#include "alikhan/colfile.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace alikhan {
+
+namespace svb {
+
+// Bytes the encoded form of `n` values can take at worst.
+constexpr std::size_t max_encoded_size(std::size_t n) noexcept {
+    return (n + 3) / 4 + n * 4;
+}
+
+// Encodes `n` values into control+data streams at `out` (laid out as
+// [control bytes][data bytes]); returns total encoded size.
+std::size_t encode(const std::uint32_t* values, std::size_t n, std::uint8_t* out);
+
+// Decodes `n` values previously encoded at `in`; `in_size` is the
+// encoded byte count and bounds the SIMD path's 16-byte loads so a
+// list at the end of a mapping never reads past it.
+std::size_t decode(const std::uint8_t* in, std::size_t in_size, std::size_t n,
+                   std::uint32_t* out);
+
+// Incremental decode: pulls values a chunk at a time so consumers
+// that stop early (lazy intersections) never unpack the whole list.
+// Keeps the same pshufb fast path as decode() for full groups.
+class Decoder {
+public:
+    Decoder(const std::uint8_t* in, std::size_t in_size,
+            std::size_t n) noexcept
+        : control_(in), data_(in + (n + 3) / 4), limit_(in + in_size),
+          n_(n) {}
+
+    std::size_t remaining() const noexcept { return n_ - i_; }
+
+    // Decodes up to `m` more values into `out`; returns the count
+    // produced (0 once the stream is exhausted). Requesting `m` in
+    // multiples of four keeps the SIMD path engaged.
+    std::size_t decode_next(std::size_t m, std::uint32_t* out) noexcept;
+
+private:
+    const std::uint8_t* control_;
+    const std::uint8_t* data_;
+    const std::uint8_t* limit_;
+    std::size_t n_;
+    std::size_t i_ = 0;
+};
+
+} // namespace svb
+
+class InvertedIndexBuilder {
+public:
+    // Registers `doc` under every token. Tokens may repeat within a
+    // document; each (term, doc) pair is stored once. Documents must
+    // be added in increasing doc id order.
+    void add_document(std::uint32_t doc, const std::string_view* tokens,
+                      std::size_t count);
+
+    std::size_t term_count() const noexcept { return postings_.size(); }
+
+    // Serializes the index as a ColumnFile snapshot. `huge_pages`
+    // lays sections out 2 MiB-aligned so the mapped snapshot is
+    // THP-eligible -- worth it from a few hundred MB up. Returns
+    // false with errno set on failure.
+    bool write(const char* path, bool huge_pages = false) const;
+
+private:
+    // std::map keeps terms sorted, which the reader's binary search
+    // relies on.
+    std::map<std::string, std::vector<std::uint32_t>, std::less<>> postings_;
+};
+
+class InvertedIndex {
+public:
+    static constexpr std::uint32_t kNoTerm = 0xFFFFFFFFu;
+
+    struct Postings {
+        std::uint32_t doc_count = 0;
+        const std::uint8_t* encoded = nullptr;   // svb control+data
+        std::size_t encoded_size = 0;
+    };
+
+    bool open(const char* path) noexcept;
+
+    // Serves a snapshot already resident in memory (e.g. a
+    // ShmSegment slot); the bytes must outlive the index.
+    bool open_bytes(const char* data, std::size_t size) noexcept;
+
+    void close() noexcept { file_.close(); }
+    bool is_open() const noexcept { return file_.is_open(); }
+
+    std::uint32_t term_count() const noexcept {
+        return std::uint32_t(terms_.row_count());
+    }
+
+    std::string_view term(std::uint32_t idx) const noexcept {
+        return terms_.get_bytes(idx);
+    }
+
+    // Binary search over the sorted term column; kNoTerm when absent.
+    std::uint32_t find_term(std::string_view t) const noexcept;
+
+    // Number of documents containing term `idx` -- available without
+    // touching the posting bytes, for query planning.
+    std::uint32_t doc_count(std::uint32_t idx) const noexcept {
+        return counts_.data<std::uint32_t>()[idx];
+    }
+
+    Postings postings(std::uint32_t idx) const noexcept {
+        const std::string_view raw = blobs_.get_bytes(idx);
+        return {doc_count(idx),
+                reinterpret_cast<const std::uint8_t*>(raw.data()), raw.size()};
+    }
+
+    // Decodes a posting list into `out` (capacity >= doc_count),
+    // un-deltaing to absolute ascending doc ids. Returns doc_count.
+    std::size_t decode_postings(const Postings& p, std::uint32_t* out) const;
+
+private:
+    ColumnFile file_;
+    ColumnView terms_;
+    ColumnView blobs_;
+    ColumnView counts_;
+};
+
+// Log-structured incremental index: a mutable in-memory delta in
+// front of the mmap snapshot. Adding the day's documents costs only
+// the delta; compact() merges the delta's posting lists into a fresh
+// snapshot file (snapshot ids sort before delta ids, so merging a
+// term is a decode + append) and swaps readers over to it.
+//
+// Two snapshot generations stay mapped: queries that started against
+// the old one finish against the old one, so compact() never blocks
+// or invalidates readers. A reader must not hold postings across two
+// compactions. One writer thread calls add_document()/compact();
+// lookups may run concurrently from any thread.
+class IncrementalIndex {
+public:
+    explicit IncrementalIndex(std::string snapshot_path)
+        : path_(std::move(snapshot_path)) {}
+
+    // Opens the current snapshot; a missing file just starts empty.
+    // Returns false on I/O or format errors.
+    bool open();
+
+    // Makes subsequent compact() snapshots huge-aligned (see
+    // InvertedIndexBuilder::write).
+    void set_huge_pages(bool on) noexcept { huge_pages_ = on; }
+
+    // Adds `doc` to the delta under every token. Doc ids ascend
+    // across the whole index, snapshot included, and each document is
+    // added once.
+    void add_document(std::uint32_t doc, const std::string_view* tokens,
+                      std::size_t count);
+
+    // Posting entries buffered in memory -- the compaction trigger.
+    std::uint64_t pending_postings() const noexcept;
+
+    // Documents containing `term` across snapshot and delta.
+    std::uint32_t doc_count(std::string_view term) const;
+
+    // Fills `out` with the ascending doc ids for `term` across
+    // snapshot and delta; returns the count.
+    std::size_t lookup(std::string_view term,
+                       std::vector<std::uint32_t>& out) const;
+
+    // Merges pending deltas into a new snapshot written over
+    // snapshot_path (via a .tmp sibling and rename) and switches
+    // readers to it. Returns false with errno on I/O failure, in
+    // which case the delta is kept and nothing is switched.
+    bool compact();
+
+    // Current snapshot generation; nullptr before the first
+    // successful compact() of a fresh index.
+    const InvertedIndex* snapshot() const noexcept {
+        const InvertedIndex& g = gens_[live_.load(std::memory_order_acquire)];
+        return g.is_open() ? &g : nullptr;
+    }
+
+private:
+    using PostingMap =
+        std::map<std::string, std::vector<std::uint32_t>, std::less<>>;
+
+    std::string path_;
+    InvertedIndex gens_[2];
+    std::atomic<unsigned> live_{0};
+    mutable std::mutex mu_;        // guards delta_, merging_, pending_
+    PostingMap delta_;             // receiving writes
+    PostingMap merging_;           // being folded into the next snapshot
+    std::uint64_t pending_ = 0;
+    bool huge_pages_ = false;
+};
+
+} // namespace alikhan
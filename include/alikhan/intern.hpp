@@ -0,0 +1,62 @@
+#pragma once
+
+// alikhan::InternPool -- token deduplication with 32-bit symbol ids.
+//
+// Ingest sees the same tokens billions of times; interning maps each
+// distinct spelling to a dense uint32 Symbol so the parser and index
+// compare integers instead of strings, and each spelling's bytes are
+// stored once. The pool is an open-addressing (linear probe) table
+// whose slot array, entry array and string bytes all come from the
+// caller's Arena -- interning performs no heap allocation.
+//
+// Growth allocates a fresh slot array from the arena and abandons the
+// old one; that garbage is reclaimed when the arena resets, which is
+// the usual arena trade and is bounded by ~2x the final table size.
+// Not thread-safe: shard pools per worker like arenas.
+
+#include "alikhan/arena.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace alikhan {
+
+class InternPool {
+public:
+    using Symbol = std::uint32_t;
+    static constexpr Symbol kInvalid = 0xFFFFFFFFu;
+
+    explicit InternPool(Arena& arena, std::size_t initial_capacity = 256);
+
+    // Returns the symbol for `s`, inserting it on first sight. Ids
+    // are dense and assigned in first-seen order.
+    Symbol intern(std::string_view s);
+
+    // Lookup without insertion; kInvalid when `s` was never interned.
+    Symbol find(std::string_view s) const noexcept;
+
+    // The canonical spelling for a symbol; valid until arena reset.
+    std::string_view text(Symbol sym) const noexcept {
+        return {entries_[sym].data, entries_[sym].len};
+    }
+
+    std::size_t size() const noexcept { return count_; }
+
+private:
+    struct Entry {
+        const char* data;
+        std::uint32_t len;
+        std::uint32_t hash;    // cached to skip memcmp on mismatches
+    };
+
+    void grow();
+
+    Arena& arena_;
+    Symbol* slots_ = nullptr;       // symbol id per slot, kInvalid = empty
+    std::size_t slot_mask_ = 0;
+    Entry* entries_ = nullptr;      // indexed by symbol
+    std::size_t entry_cap_ = 0;
+    std::size_t count_ = 0;
+};
+
+} // namespace alikhan
@@ -0,0 +1,107 @@
+#pragma once
+
+// alikhan::IoEngine -- batched asynchronous file reader for corpus
+// ingestion.
+//
+// The ingest tier reads hundreds of thousands of small documents per
+// run; issuing them one blocking read at a time leaves NVMe queue
+// depth unused. IoEngine keeps up to queue_depth reads in flight at
+// once: on kernels with io_uring it drives the ring directly via the
+// raw syscalls (no liburing dependency), elsewhere it falls back to
+// plain pread so callers never need to care which path is active.
+//
+// Usage: submit_read() any number of files, then run(); the engine
+// pipelines opens/reads/closes and invokes each callback on the
+// calling thread as its data arrives, typically handing the buffer
+// straight to ResumeParser. Buffers are owned by the engine and valid
+// only for the duration of the callback.
+//
+// With Options::adaptive set, the fixed in-flight cap becomes an upper
+// bound and a PrefetchController per backing device (keyed by st_dev)
+// sets the working depth and readahead from observed completion
+// latencies, so one engine serves NVMe and network filesystems in the
+// same run without static per-fleet tuning.
+
+#include "alikhan/prefetch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alikhan {
+
+class IoEngine {
+public:
+    struct Options {
+        unsigned queue_depth = 64;          // in-flight read cap
+        std::size_t max_file_size = 64u << 20;   // larger files fail E2BIG
+        bool adaptive = false;              // latency-driven per-device depth
+        PrefetchController::Options prefetch;    // used when adaptive
+    };
+
+    // path, file contents (empty on error), 0 or errno.
+    using ReadCallback =
+        std::function<void(const std::string& path, std::string_view data, int error)>;
+
+    IoEngine();
+    explicit IoEngine(Options opts);
+    ~IoEngine();
+
+    IoEngine(const IoEngine&) = delete;
+    IoEngine& operator=(const IoEngine&) = delete;
+
+    // Queues a file; no I/O happens until run().
+    void submit_read(std::string path, ReadCallback cb);
+
+    // Drives all queued reads to completion, invoking callbacks on
+    // this thread as completions arrive. Returns the number of files
+    // that completed without error.
+    std::size_t run();
+
+    // True when this engine is driving a real io_uring (as opposed to
+    // the pread fallback).
+    bool using_uring() const noexcept;
+
+    unsigned queue_depth() const noexcept { return opts_.queue_depth; }
+
+    // The controller admitting reads for `path`'s backing device, or
+    // nullptr when not adaptive / no read has touched the device yet.
+    // Controllers persist across run() calls so later batches start
+    // from the learned depth.
+    const PrefetchController* controller(const std::string& path) const noexcept;
+
+private:
+    struct Ring;                 // raw io_uring state, see io_engine.cpp
+    struct Request {
+        std::string path;
+        ReadCallback cb;
+        std::unique_ptr<char[]> buf;
+        std::size_t size = 0;
+        int fd = -1;
+        std::uint64_t dev = 0;        // st_dev, the controller key
+        std::uint64_t submit_ns = 0;
+    };
+    struct DeviceState {
+        PrefetchController ctl;
+        unsigned inflight = 0;
+        explicit DeviceState(const PrefetchController::Options& o) noexcept
+            : ctl(o) {}
+    };
+
+    std::size_t run_uring();
+    std::size_t run_fallback();
+    bool prepare(Request& req);   // open + stat + buffer; sets errno
+    DeviceState& device(std::uint64_t dev);
+
+    Options opts_;
+    std::vector<Request> queue_;
+    std::unique_ptr<Ring> ring_;
+    std::map<std::uint64_t, DeviceState> devices_;
+};
+
+} // namespace alikhan
@@ -0,0 +1,86 @@
+#pragma once
+
+// alikhan::MappedFile -- zero-copy document loader.
+//
+// Maps a file read-only and exposes its contents as string_view
+// slices, so ingest never copies document bytes into userland buffers:
+// the parser tokenizes directly over the page cache. Advice hints let
+// callers tell the kernel the access pattern up front (sequential scan
+// for whole-document parses, will-need to prefault a region before the
+// parser reaches it).
+//
+// open() reports failure by returning false with errno left set, like
+// the system calls it wraps; a default-constructed or failed
+// MappedFile is empty and safe to query.
+
+#include <cstddef>
+#include <string_view>
+
+namespace alikhan {
+
+class MappedFile {
+public:
+    enum class Advice {
+        Normal,      // no hint
+        Sequential,  // aggressive readahead, drop pages behind the scan
+        Random,      // disable readahead
+        WillNeed,    // prefetch now
+        Huge,        // collapse to transparent huge pages where backed
+    };
+
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // Maps `path` read-only. An empty file maps successfully with
+    // size() == 0. Returns false with errno set on failure.
+    bool open(const char* path) noexcept;
+
+    // Unmaps; the object becomes empty. Any string_view previously
+    // handed out is invalidated.
+    void close() noexcept;
+
+    bool is_open() const noexcept { return data_ != nullptr; }
+    const char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+    // Whole file as one slice. Valid until close().
+    std::string_view view() const noexcept { return {data_, size_}; }
+
+    // Sub-slice [offset, offset + length), clamped to the file.
+    std::string_view slice(std::size_t offset, std::size_t length) const noexcept {
+        if (offset > size_) return {};
+        if (length > size_ - offset) length = size_ - offset;
+        return {data_ + offset, length};
+    }
+
+    // Applies an madvise hint to the whole mapping (or a sub-range).
+    // Advisory only: failure is ignored beyond the return value.
+    bool advise(Advice a) const noexcept { return advise(a, 0, size_); }
+    bool advise(Advice a, std::size_t offset, std::size_t length) const noexcept;
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace alikhan
@@ -0,0 +1,142 @@
+#pragma once
+
+// alikhan::MpmcQueue<T> -- bounded lock-free multi-producer
+// multi-consumer ring.
+//
+// Vyukov's bounded MPMC scheme: each slot carries a sequence counter
+// that encodes whose turn it is, so producers and consumers claim
+// slots with one fetch_add on their own cursor and never contend on a
+// shared lock. Slots and the two cursors are cache-line padded so a
+// producer burst does not false-share with consumers.
+//
+// try_push/try_pop fail (return false) when the ring is full/empty
+// rather than blocking; callers that want backpressure spin or park at
+// a higher level (the Executor does the latter). Capacity is rounded
+// up to a power of two.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace alikhan {
+
+inline constexpr std::size_t kCacheLineSize = 64;
+
+template <typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap *= 2;
+        mask_ = cap - 1;
+        slots_ = static_cast<Slot*>(::operator new[](cap * sizeof(Slot),
+                                                     std::align_val_t{kCacheLineSize}));
+        for (std::size_t i = 0; i < cap; ++i) {
+            ::new (&slots_[i]) Slot();
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue() {
+        T tmp;
+        while (try_pop(tmp)) {}
+        for (std::size_t i = 0; i <= mask_; ++i) slots_[i].~Slot();
+        ::operator delete[](slots_, std::align_val_t{kCacheLineSize});
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Enqueues by move; returns false if the ring is full, in which
+    // case `value` is left untouched so callers can retry or reroute.
+    bool try_push(T&& value) noexcept {
+        Slot* slot;
+        std::uint64_t pos;
+        if (!claim_push_slot(slot, pos)) return false;
+        ::new (&slot->storage) T(std::move(value));
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value) noexcept {
+        Slot* slot;
+        std::uint64_t pos;
+        if (!claim_push_slot(slot, pos)) return false;
+        ::new (&slot->storage) T(value);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Dequeues into `out`; returns false if the ring is empty.
+    bool try_pop(T& out) noexcept {
+        Slot* slot;
+        std::uint64_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const std::uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const std::int64_t diff = std::int64_t(seq) - std::int64_t(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;   // not yet published: empty
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+        T* item = std::launder(reinterpret_cast<T*>(&slot->storage));
+        out = std::move(*item);
+        item->~T();
+        slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate; only exact when no producer/consumer is in flight.
+    std::size_t size_approx() const noexcept {
+        const std::uint64_t t = tail_.load(std::memory_order_relaxed);
+        const std::uint64_t h = head_.load(std::memory_order_relaxed);
+        return t > h ? std::size_t(t - h) : 0;
+    }
+
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+private:
+    struct Slot;
+
+    bool claim_push_slot(Slot*& slot, std::uint64_t& out_pos) noexcept {
+        std::uint64_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const std::uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const std::int64_t diff = std::int64_t(seq) - std::int64_t(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+                    out_pos = pos;
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // slot still owned by a lagging consumer: full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<std::uint64_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    Slot* slots_ = nullptr;
+    std::size_t mask_ = 0;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> tail_{0};   // producers
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{0};   // consumers
+};
+
+} // namespace alikhan
@@ -0,0 +1,67 @@
+#pragma once
+
+// NUMA topology and memory/worker placement.
+//
+// Dual-socket boxes split the parse pipeline's tail latency when
+// arenas and workers land on opposite nodes. This layer keeps it
+// local: per-node Arena shards, worker pinning, and the node lookup
+// the Executor uses to steal from same-node workers before crossing
+// the interconnect.
+//
+// Topology comes from sysfs (/sys/devices/system/node) and pinning
+// from sched_setaffinity, so there is no libnuma link dependency; on
+// single-node machines everything degrades to node 0 and pinning
+// becomes a no-op that still succeeds.
+
+#include "alikhan/arena.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace alikhan {
+namespace numa {
+
+// Number of online NUMA nodes; 1 on non-NUMA systems.
+unsigned node_count() noexcept;
+
+// True when more than one node is online.
+bool available() noexcept;
+
+// Node owning `cpu`; 0 if unknown.
+unsigned node_of_cpu(unsigned cpu) noexcept;
+
+// Node the calling thread is currently running on.
+unsigned current_node() noexcept;
+
+// Restricts the calling thread to the CPUs of `node`. Returns false
+// with errno set if the affinity call fails.
+bool pin_thread_to_node(unsigned node) noexcept;
+
+} // namespace numa
+
+// One Arena per NUMA node. Threads allocate from their local node's
+// shard, so first-touch places pages locally; pair with pinned
+// Executor workers to keep them there.
+class NumaArenaSet {
+public:
+    explicit NumaArenaSet(std::size_t block_size = Arena::kDefaultBlockSize);
+
+    // The calling thread's local shard.
+    Arena& local() noexcept { return shard(numa::current_node()); }
+
+    Arena& shard(unsigned node) noexcept {
+        return *shards_[node < shards_.size() ? node : 0];
+    }
+
+    unsigned shard_count() const noexcept { return unsigned(shards_.size()); }
+
+    // Resets every shard; callers must quiesce allocating threads
+    // first, same as with a single Arena.
+    void reset_all() noexcept;
+
+private:
+    std::vector<std::unique_ptr<Arena>> shards_;
+};
+
+} // namespace alikhan
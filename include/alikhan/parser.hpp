@@ -0,0 +1,68 @@
+#pragma once
+
+// alikhan::ResumeParser -- structured parser for resume/Markdown
+// documents.
+//
+// The input is the README-style document class: Markdown headings
+// ("# Experience", "## Skills") delimiting sections of prose. The
+// parser splits the document into sections and tokenizes each body
+// into word tokens (runs of identifier-ish bytes; '@', '+', '.', '-'
+// are kept inside a token so emails, phone numbers and terms like
+// "C++" survive intact).
+//
+// Everything the parser returns is a string_view into the caller's
+// buffer -- typically a MappedFile -- and the records themselves live
+// in the caller's Arena. parse() performs no heap allocation: each
+// section's tokens go into a SmallVec whose inline slots cover the
+// typical short section and which spills into the arena for long
+// ones, so tokenizing is a single pass. The returned Document is
+// valid until the arena is reset.
+
+#include "alikhan/arena.hpp"
+#include "alikhan/small.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace alikhan {
+
+struct Section {
+    // Inline token slots per section; README-style sections are a
+    // heading plus a sentence or two, so most stay inline.
+    static constexpr std::size_t kInlineTokens = 8;
+
+    std::string_view heading;        // heading text without '#' marks;
+                                     // empty for the implicit preamble
+    int level = 0;                   // number of '#'s; 0 for preamble
+    std::string_view body;           // raw text up to the next heading
+    SmallVec<std::string_view, kInlineTokens> tokens;
+};
+
+struct Document {
+    std::string_view text;           // the full input
+    const Section* sections = nullptr;
+    std::size_t section_count = 0;
+    std::size_t token_count = 0;     // across all sections
+};
+
+class ResumeParser {
+public:
+    explicit ResumeParser(Arena& arena) noexcept : arena_(arena) {}
+
+    // Parses `text` and returns an arena-allocated Document whose
+    // views alias `text`. Never fails: malformed input degrades to
+    // one preamble section.
+    const Document* parse(std::string_view text);
+
+private:
+    Arena& arena_;
+};
+
+// True for bytes that belong inside a token.
+constexpr bool is_token_byte(unsigned char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '@' || c == '+' || c == '.' ||
+           c == '-' || c == '_';
+}
+
+} // namespace alikhan
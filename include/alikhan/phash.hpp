@@ -0,0 +1,170 @@
+#pragma once
+
+// alikhan::StaticPerfectHash<N> -- compile-time perfect hash table.
+//
+// Builds a minimal-collision lookup structure over a fixed keyword
+// list entirely in constexpr evaluation (hash-displace-compose, the
+// CHD scheme): keys are first hashed into buckets, then each bucket
+// -- largest first -- searches for a displacement seed that lands all
+// of its keys in free slots of the main table. Lookup is two short
+// hashes, one displacement load and one final string compare; there
+// is no probing, no pointer chasing and no runtime construction.
+//
+//     static constexpr std::string_view kKeywords[] = {"skills", ...};
+//     static constexpr auto kTable =
+//         alikhan::make_perfect_hash(kKeywords);
+//     std::uint32_t idx = kTable.lookup(token);   // npos if absent
+//
+// lookup() returns the key's index in the original list, so callers
+// can hang payload arrays off the same indices.
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace alikhan {
+
+namespace phash_detail {
+
+constexpr std::uint64_t hash(std::string_view s, std::uint64_t seed) noexcept {
+    std::uint64_t h = 1469598103934665603ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (char c : s) {
+        h ^= std::uint8_t(c);
+        h *= 1099511628211ull;
+    }
+    return h ^ (h >> 32);
+}
+
+constexpr std::size_t next_pow2(std::size_t v) noexcept {
+    std::size_t p = 1;
+    while (p < v) p *= 2;
+    return p;
+}
+
+} // namespace phash_detail
+
+template <std::size_t N>
+class StaticPerfectHash {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    // Table of 2N slots keeps the displacement search short; B buckets
+    // average two keys each.
+    static constexpr std::size_t kSlots = phash_detail::next_pow2(2 * N);
+    static constexpr std::size_t kBuckets = phash_detail::next_pow2(N / 2 + 1);
+
+    constexpr explicit StaticPerfectHash(const std::string_view (&keys)[N])
+        : keys_{} {
+        for (std::size_t i = 0; i < N; ++i) keys_[i] = keys[i];
+        for (auto& s : slot_to_key_) s = npos;
+        for (auto& d : disp_) d = 0;
+
+        // Group keys by bucket.
+        std::array<std::uint32_t, N> order{};
+        std::array<std::uint32_t, kBuckets> bucket_size{};
+        for (std::size_t i = 0; i < N; ++i)
+            ++bucket_size[bucket_of(keys_[i])];
+
+        // Process buckets largest first: big buckets get first pick of
+        // free slots, which keeps displacement seeds small.
+        std::array<std::uint32_t, kBuckets> bucket_order{};
+        for (std::size_t b = 0; b < kBuckets; ++b)
+            bucket_order[b] = std::uint32_t(b);
+        for (std::size_t i = 0; i + 1 < kBuckets; ++i)
+            for (std::size_t j = i + 1; j < kBuckets; ++j)
+                if (bucket_size[bucket_order[j]] > bucket_size[bucket_order[i]]) {
+                    const auto t = bucket_order[i];
+                    bucket_order[i] = bucket_order[j];
+                    bucket_order[j] = t;
+                }
+
+        bool occupied[kSlots] = {};
+        for (std::size_t bi = 0; bi < kBuckets; ++bi) {
+            const std::uint32_t b = bucket_order[bi];
+            const std::uint32_t size = bucket_size[b];
+            if (size == 0) continue;
+
+            std::uint32_t members = 0;
+            for (std::size_t i = 0; i < N; ++i)
+                if (bucket_of(keys_[i]) == b) order[members++] = std::uint32_t(i);
+
+            if (size == 1) {
+                // Singletons take the next free slot directly; the
+                // displacement stores it as -(slot + 1).
+                std::size_t s = 0;
+                while (occupied[s]) ++s;
+                occupied[s] = true;
+                slot_to_key_[s] = order[0];
+                disp_[b] = -std::int32_t(s) - 1;
+                continue;
+            }
+
+            for (std::int32_t d = 1;; ++d) {
+                bool ok = true;
+                std::size_t taken[N] = {};
+                std::size_t ntaken = 0;
+                for (std::uint32_t k = 0; k < size && ok; ++k) {
+                    const std::size_t s =
+                        slot_of(phash_detail::hash(keys_[order[k]], 0), d);
+                    if (occupied[s]) ok = false;
+                    for (std::size_t t = 0; t < ntaken && ok; ++t)
+                        if (taken[t] == s) ok = false;
+                    if (ok) taken[ntaken++] = s;
+                }
+                if (ok) {
+                    for (std::uint32_t k = 0; k < size; ++k) {
+                        const std::size_t s =
+                            slot_of(phash_detail::hash(keys_[order[k]], 0), d);
+                        occupied[s] = true;
+                        slot_to_key_[s] = order[k];
+                    }
+                    disp_[b] = d;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Index of `key` in the construction list, or npos. The key is
+    // hashed once; bucket and slot are both derived from that hash.
+    constexpr std::uint32_t lookup(std::string_view key) const noexcept {
+        const std::uint64_t h = phash_detail::hash(key, 0);
+        const std::int32_t d = disp_[h & (kBuckets - 1)];
+        const std::size_t s =
+            d < 0 ? std::size_t(-d - 1) : slot_of(h, d);
+        const std::uint32_t idx = slot_to_key_[s];
+        if (idx == npos || keys_[idx] != key) return npos;
+        return idx;
+    }
+
+    constexpr bool contains(std::string_view key) const noexcept {
+        return lookup(key) != npos;
+    }
+
+    static constexpr std::size_t size() noexcept { return N; }
+
+private:
+    static constexpr std::uint32_t bucket_of(std::string_view key) noexcept {
+        return std::uint32_t(phash_detail::hash(key, 0) & (kBuckets - 1));
+    }
+    // Remixes the base hash with the displacement seed; cheap enough
+    // that lookup never rescans the key bytes.
+    static constexpr std::size_t slot_of(std::uint64_t h,
+                                         std::int32_t d) noexcept {
+        std::uint64_t x = h ^ (std::uint64_t(std::uint32_t(d)) * 0x9E3779B97F4A7C15ull);
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        return std::size_t(x & (kSlots - 1));
+    }
+
+    std::array<std::string_view, N> keys_;
+    std::array<std::int32_t, kBuckets> disp_{};
+    std::array<std::uint32_t, kSlots> slot_to_key_{};
+};
+
+template <std::size_t N>
+constexpr StaticPerfectHash<N> make_perfect_hash(const std::string_view (&keys)[N]) {
+    return StaticPerfectHash<N>(keys);
+}
+
+} // namespace alikhan
@@ -0,0 +1,374 @@
+#pragma once
+
+// Coroutine pipeline composition over the work-stealing Executor.
+//
+// Three pieces replace the callback glue between ingest stages:
+//
+//   * Task<T>: a lazy coroutine task. Awaiting it starts the child
+//     and resumes the parent by symmetric transfer when the child
+//     finishes -- one coroutine-frame allocation per task, no heap
+//     allocation per continuation hop.
+//
+//   * Channel<T>: bounded inter-stage buffer on MpmcQueue. push()
+//     and pop() are awaitables; when the ring is full/empty the
+//     awaiting coroutine re-queues itself on the Executor instead of
+//     blocking a worker, so stages keep the pool busy. close() lets
+//     pop() drain remaining items and then return nullopt.
+//
+//   * Pipeline: spawns Task<void> stages onto an Executor and joins
+//     them in wait(). A read -> parse -> index pipeline is three
+//     stage coroutines connected by two channels.
+//
+// The channel retry lambdas capture {awaiter, handle} and fit in
+// std::function's small-object buffer, so steady-state item flow does
+// not heap-allocate per item. Stage coroutines must not leak
+// exceptions (the stage wrapper terminates if one does); report
+// errors through the channel payload instead.
+
+#include "alikhan/executor.hpp"
+#include "alikhan/mpmc_queue.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <semaphore>
+#include <utility>
+
+namespace alikhan {
+
+namespace pipeline_detail {
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<Promise> h) noexcept {
+            auto cont = h.promise().continuation;
+            return cont ? cont : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+// Fire-and-forget driver coroutine: starts eagerly, frame cleans
+// itself up when the body finishes.
+struct OneWay {
+    struct promise_type {
+        OneWay get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+} // namespace pipeline_detail
+
+template <typename T = void>
+class [[nodiscard]] Task {
+public:
+    struct promise_type : pipeline_detail::TaskPromiseBase {
+        std::optional<T> value;
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        void return_value(T v) { value.emplace(std::move(v)); }
+    };
+
+    Task() noexcept = default;
+    Task(Task&& other) noexcept : h_(std::exchange(other.h_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(other.h_, {});
+        }
+        return *this;
+    }
+    ~Task() {
+        if (h_) h_.destroy();
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool valid() const noexcept { return bool(h_); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> h;
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> cont) noexcept {
+                h.promise().continuation = cont;
+                return h;   // symmetric transfer into the child
+            }
+            T await_resume() {
+                if (h.promise().error)
+                    std::rethrow_exception(h.promise().error);
+                return std::move(*h.promise().value);
+            }
+        };
+        return Awaiter{h_};
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : h_(h) {}
+    std::coroutine_handle<promise_type> h_;
+};
+
+template <>
+class [[nodiscard]] Task<void> {
+public:
+    struct promise_type : pipeline_detail::TaskPromiseBase {
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        void return_void() noexcept {}
+    };
+
+    Task() noexcept = default;
+    Task(Task&& other) noexcept : h_(std::exchange(other.h_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(other.h_, {});
+        }
+        return *this;
+    }
+    ~Task() {
+        if (h_) h_.destroy();
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool valid() const noexcept { return bool(h_); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> h;
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> cont) noexcept {
+                h.promise().continuation = cont;
+                return h;
+            }
+            void await_resume() {
+                if (h.promise().error)
+                    std::rethrow_exception(h.promise().error);
+            }
+        };
+        return Awaiter{h_};
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : h_(h) {}
+    std::coroutine_handle<promise_type> h_;
+};
+
+// Runs a task to completion and returns its result. The calling
+// thread blocks (it does not steal work) while the task and anything
+// it hops onto an executor complete.
+template <typename U>
+U sync_wait(Task<U> task) {
+    std::binary_semaphore done{0};
+    std::optional<U> result;
+    std::exception_ptr error;
+    [](Task<U> t, std::optional<U>& out, std::exception_ptr& err,
+       std::binary_semaphore& sem) -> pipeline_detail::OneWay {
+        try {
+            out.emplace(co_await std::move(t));
+        } catch (...) {
+            err = std::current_exception();
+        }
+        sem.release();
+    }(std::move(task), result, error, done);
+    done.acquire();
+    if (error) std::rethrow_exception(error);
+    return std::move(*result);
+}
+
+inline void sync_wait(Task<> task) {
+    std::binary_semaphore done{0};
+    std::exception_ptr error;
+    [](Task<> t, std::exception_ptr& err,
+       std::binary_semaphore& sem) -> pipeline_detail::OneWay {
+        try {
+            co_await std::move(t);
+        } catch (...) {
+            err = std::current_exception();
+        }
+        sem.release();
+    }(std::move(task), error, done);
+    done.acquire();
+    if (error) std::rethrow_exception(error);
+}
+
+// Suspends the awaiting coroutine and resumes it on `ex` -- the hop
+// that moves a stage onto the pool.
+inline auto schedule_on(Executor& ex) noexcept {
+    struct Awaiter {
+        Executor& ex;
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            ex.submit([h] { h.resume(); });
+        }
+        void await_resume() noexcept {}
+    };
+    return Awaiter{ex};
+}
+
+// Bounded typed buffer between pipeline stages.
+template <typename T>
+class Channel {
+public:
+    Channel(Executor& ex, std::size_t capacity) : ex_(ex), q_(capacity) {}
+
+    // co_await ch.push(v): completes once v is in the ring. A full
+    // ring re-queues the coroutine on the executor and retries
+    // instead of blocking the worker.
+    auto push(T value) noexcept {
+        struct Awaiter {
+            Channel& ch;
+            T value;
+            bool await_ready() { return ch.q_.try_push(std::move(value)); }
+            void await_suspend(std::coroutine_handle<> h) { retry(h); }
+            void retry(std::coroutine_handle<> h) {
+                // try_push leaves `value` intact on failure.
+                if (ch.q_.try_push(std::move(value))) {
+                    h.resume();
+                    return;
+                }
+                ch.ex_.submit([this, h] { retry(h); });
+            }
+            void await_resume() noexcept {}
+        };
+        return Awaiter{*this, std::move(value)};
+    }
+
+    // co_await ch.pop(): the next item, or nullopt once the channel
+    // is closed and drained.
+    auto pop() noexcept {
+        struct Awaiter {
+            Channel& ch;
+            std::optional<T> out;
+            bool try_fill() {
+                T v;
+                if (ch.q_.try_pop(v)) {
+                    out.emplace(std::move(v));
+                    return true;
+                }
+                return false;
+            }
+            bool await_ready() {
+                if (try_fill()) return true;
+                if (ch.closed()) {
+                    try_fill();   // race with a final push before close()
+                    return true;  // out empty -> nullopt
+                }
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> h) { retry(h); }
+            void retry(std::coroutine_handle<> h) {
+                if (try_fill() || ch.closed()) {
+                    if (!out) try_fill();
+                    h.resume();
+                    return;
+                }
+                ch.ex_.submit([this, h] { retry(h); });
+            }
+            std::optional<T> await_resume() noexcept { return std::move(out); }
+        };
+        return Awaiter{*this, std::nullopt};
+    }
+
+    // Producers call close() when done pushing; buffered items stay
+    // poppable.
+    void close() noexcept { closed_.store(true, std::memory_order_release); }
+
+    bool closed() const noexcept {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+private:
+    Executor& ex_;
+    MpmcQueue<T> q_;
+    std::atomic<bool> closed_{false};
+};
+
+// Owns a set of stage tasks running on one Executor.
+class Pipeline {
+public:
+    explicit Pipeline(Executor& ex) noexcept : ex_(ex) {}
+
+    ~Pipeline() { wait(); }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Schedules `stage` onto the executor; the stage wrapper owns the
+    // task and notifies the pipeline when it completes.
+    void spawn(Task<> stage) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        StageTask st = run_stage(std::move(stage));
+        st.h.promise().owner = this;
+        ex_.submit([h = st.h] { h.resume(); });
+    }
+
+    // Blocks until every spawned stage has finished.
+    void wait() {
+        while (pending_.load(std::memory_order_acquire) != 0)
+            done_.acquire();
+    }
+
+private:
+    // Self-cleaning stage wrapper: the frame destroys itself at final
+    // suspend, then signals the pipeline, so no handle outlives the
+    // stage and wait() can return the moment the count hits zero.
+    struct StageTask {
+        struct promise_type {
+            Pipeline* owner = nullptr;
+            StageTask get_return_object() noexcept {
+                return {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            struct Final {
+                bool await_ready() noexcept { return false; }
+                void await_suspend(
+                    std::coroutine_handle<promise_type> h) noexcept {
+                    Pipeline* p = h.promise().owner;
+                    h.destroy();
+                    p->notify();
+                }
+                void await_resume() noexcept {}
+            };
+            Final final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            // Stages report errors through channel payloads; an
+            // escaping exception is a bug.
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+        std::coroutine_handle<promise_type> h;
+    };
+
+    static StageTask run_stage(Task<> stage) { co_await std::move(stage); }
+
+    void notify() {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            done_.release();
+    }
+
+    Executor& ex_;
+    std::atomic<std::size_t> pending_{0};
+    std::counting_semaphore<> done_{0};
+};
+
+} // namespace alikhan
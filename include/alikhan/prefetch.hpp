@@ -0,0 +1,71 @@
+#pragma once
+
+// alikhan::PrefetchController -- latency-driven admission control for
+// asynchronous reads.
+//
+// A fixed io_uring queue depth tuned for local NVMe floods a network
+// filesystem (99th-percentile completion spikes as the server queues),
+// while a depth tuned for the network path starves the flash. The
+// controller closes the loop instead: callers feed it every completion
+// latency and ask it how many reads to keep in flight and how far to
+// ask the kernel to read ahead.
+//
+// The policy is AIMD against a latency floor. The floor tracks the
+// best completion time the device has shown (decaying slowly upward so
+// a migrated volume is re-learned); each window of completions is
+// compared against it, and a 99th percentile more than `spike` times
+// the floor halves the depth and readahead while a clean window adds
+// one slot and a readahead step. That keeps the parse pipeline fed at
+// the device's knee without the tail spikes a static depth causes on
+// the slow tier.
+//
+// One controller per backing device; IoEngine keys them by st_dev when
+// Options::adaptive is set. Not thread-safe -- the engine drives it
+// from its single submission thread.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace alikhan {
+
+class PrefetchController {
+public:
+    struct Options {
+        unsigned min_depth = 4;
+        unsigned max_depth = 256;
+        unsigned initial_depth = 32;
+        std::size_t min_readahead = 128u << 10;
+        std::size_t max_readahead = 8u << 20;
+        double spike = 2.0;   // p99 above spike * floor backs off
+    };
+
+    PrefetchController() noexcept : PrefetchController(Options{}) {}
+    explicit PrefetchController(Options opts) noexcept;
+
+    // Feeds one completion latency; adapts once per kWindow samples.
+    void record(std::uint64_t latency_us) noexcept;
+
+    // Reads to keep in flight on this device right now.
+    unsigned depth() const noexcept { return depth_; }
+
+    // Bytes worth of kernel readahead to request per file.
+    std::size_t readahead() const noexcept { return readahead_; }
+
+    // Best completion latency seen (the congestion-free baseline);
+    // 0 before the first sample.
+    std::uint64_t latency_floor_us() const noexcept { return floor_us_; }
+
+private:
+    static constexpr std::size_t kWindow = 64;
+
+    void adapt() noexcept;
+
+    Options opts_;
+    unsigned depth_;
+    std::size_t readahead_;
+    std::uint64_t floor_us_ = 0;
+    std::uint64_t window_[kWindow];
+    std::size_t filled_ = 0;
+};
+
+} // namespace alikhan
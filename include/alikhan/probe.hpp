@@ -0,0 +1,113 @@
+#pragma once
+
+// alikhan::Probe -- hot-path latency instrumentation.
+//
+// A Probe is a lock-free HDR-style histogram (64 power-of-two major
+// buckets x 16 linear sub-buckets, relaxed atomic counters) recording
+// nanosecond durations. Probes register themselves on an intrusive
+// global list at construction, so write_probe_report() can export
+// every stage's count and p50/p90/p99/max in the bench_output.txt
+// record style without the probes knowing about each other.
+//
+// Instrument with the macros:
+//
+//     AK_PROBE_DEFINE(parse_stage);
+//     void parse(...) { AK_PROBE_SCOPE(parse_stage); ... }
+//
+// When ALIKHAN_PROBES_ENABLED is 0 (the default for release builds of
+// the library target; see the ALIKHAN_ENABLE_PROBES CMake option) the
+// macros expand to nothing and no probe code or data is emitted at
+// the instrumented sites -- record_ns costs literally zero compiled
+// out, and two relaxed increments compiled in.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#ifndef ALIKHAN_PROBES_ENABLED
+#define ALIKHAN_PROBES_ENABLED 0
+#endif
+
+namespace alikhan {
+
+class Probe {
+public:
+    static constexpr unsigned kMajor = 64;
+    static constexpr unsigned kMinor = 16;
+
+    explicit Probe(const char* name) noexcept;
+
+    void record_ns(std::uint64_t ns) noexcept {
+        counts_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const char* name() const noexcept { return name_; }
+    std::uint64_t count() const noexcept {
+        return total_.load(std::memory_order_relaxed);
+    }
+
+    // Approximate quantile (bucket lower bound), q in [0, 1].
+    std::uint64_t quantile_ns(double q) const noexcept;
+    std::uint64_t max_ns() const noexcept;
+
+    // Head of the global probe list, for report writers.
+    static Probe* first() noexcept;
+    Probe* next() const noexcept { return next_; }
+
+private:
+    static unsigned bucket_of(std::uint64_t ns) noexcept {
+        const unsigned major = 63u - unsigned(__builtin_clzll(ns | 1));
+        const unsigned minor =
+            major >= 4 ? unsigned((ns >> (major - 4)) & (kMinor - 1))
+                       : unsigned(ns & (kMinor - 1));
+        return major * kMinor + minor;
+    }
+
+    static std::uint64_t bucket_floor(unsigned bucket) noexcept {
+        const unsigned major = bucket / kMinor;
+        const unsigned minor = bucket % kMinor;
+        if (major < 4) return minor;
+        return (std::uint64_t(1) << major) |
+               (std::uint64_t(minor) << (major - 4));
+    }
+
+    const char* name_;
+    Probe* next_;
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> counts_[kMajor * kMinor];
+};
+
+// RAII timer feeding a probe.
+class ProbeScope {
+public:
+    explicit ProbeScope(Probe& p) noexcept
+        : probe_(p), start_(std::chrono::steady_clock::now()) {}
+    ~ProbeScope() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start_)
+                            .count();
+        probe_.record_ns(std::uint64_t(ns));
+    }
+    ProbeScope(const ProbeScope&) = delete;
+    ProbeScope& operator=(const ProbeScope&) = delete;
+
+private:
+    Probe& probe_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// One "name<TAB>count<TAB>p50<TAB>p90<TAB>p99<TAB>max" line per probe.
+bool write_probe_report(const char* path);
+
+} // namespace alikhan
+
+#if ALIKHAN_PROBES_ENABLED
+#define AK_PROBE_DEFINE(ident) static ::alikhan::Probe ak_probe_##ident(#ident)
+#define AK_PROBE_SCOPE(ident) ::alikhan::ProbeScope ak_probe_scope_##ident(ak_probe_##ident)
+#define AK_PROBE_RECORD_NS(ident, ns) ak_probe_##ident.record_ns(ns)
+#else
+#define AK_PROBE_DEFINE(ident) static_assert(true)
+#define AK_PROBE_SCOPE(ident) do {} while (0)
+#define AK_PROBE_RECORD_NS(ident, ns) do {} while (0)
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+
+// alikhan::QueryPlan -- cost-ordered lazy AND over posting lists.
+//
+// A skill-matching query intersects 5..20 terms whose posting lists
+// differ in length by orders of magnitude. The plan sorts terms by
+// doc_count (available without touching posting bytes), drives the
+// intersection from the rarest list, and advances every other list
+// with galloping search, so each candidate costs O(log skip) in the
+// long lists instead of a linear merge.
+//
+// Evaluation is lazy end to end: next() yields one matching doc at a
+// time and the non-driver lists decode incrementally (svb::Decoder)
+// only as far as the current candidate, so a LIMIT-10 query unpacks
+// a few hundred postings out of a million-entry list and stops.
+//
+// The plan borrows the index's mapping; it must not outlive the
+// InvertedIndex (or the snapshot generation) it was built from.
+
+#include "alikhan/index.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace alikhan {
+
+class QueryPlan {
+public:
+    // Plans the intersection of `count` terms. A term missing from
+    // the index empties the whole conjunction.
+    QueryPlan(const InvertedIndex& idx, const std::string_view* terms,
+              std::size_t count);
+
+    // True when some term is absent or the intersection cannot match.
+    bool empty() const noexcept { return empty_; }
+
+    // Upper bound on result count: the driver list's length.
+    std::uint32_t cost() const noexcept {
+        return std::uint32_t(driver_.size());
+    }
+
+    // Yields the next matching doc id in ascending order; false when
+    // the intersection is exhausted.
+    bool next(std::uint32_t& doc);
+
+    // Collects up to `limit` matches into `out`; returns the count.
+    std::size_t run(std::uint32_t* out, std::size_t limit);
+
+private:
+    // One non-driver list: decoded lazily in chunks, searched with a
+    // monotone galloping cursor.
+    struct Cursor {
+        Cursor(const InvertedIndex::Postings& p) noexcept
+            : dec(p.encoded, p.encoded_size, p.doc_count) {}
+
+        // Positions the cursor at the first doc >= target; false when
+        // the list ends below it. docs[pos] is then the hit or the
+        // next larger id.
+        bool seek(std::uint32_t target);
+
+        std::uint32_t current() const noexcept { return docs[pos]; }
+
+        svb::Decoder dec;
+        std::vector<std::uint32_t> docs;   // decoded prefix, absolute ids
+        std::size_t pos = 0;
+    };
+
+    std::vector<std::uint32_t> driver_;    // rarest list, fully decoded
+    std::size_t dpos_ = 0;
+    std::vector<Cursor> others_;           // remaining lists, cost ascending
+    bool empty_ = false;
+};
+
+} // namespace alikhan
@@ -0,0 +1,96 @@
+#pragma once
+
+// alikhan::ShmSegment -- shared-memory snapshot publication.
+//
+// The ingest daemon and its query sidecars currently reserialize
+// index data over local sockets. A ShmSegment is one POSIX shared
+// memory object both sides map: the daemon publishes serialized
+// ColumnFile / InvertedIndex snapshots into it and sidecars open
+// them in place (ColumnFile::open_bytes / InvertedIndex::open_bytes),
+// so a snapshot swap is a seqlock-protected descriptor flip, never a
+// multi-gigabyte copy over a pipe.
+//
+// The payload area is split into two slots. publish() copies the new
+// snapshot into the standby slot -- readers never touch it -- and
+// then flips the active descriptor inside a two-increment seqlock
+// critical section. read() retries the descriptor until it observes
+// a stable even sequence; validate() re-checks a view's epoch, so a
+// reader that scans for a while confirms its slot was not recycled
+// (a slot survives exactly one subsequent publish, like the index's
+// snapshot generations).
+//
+// One writer (the creator); any number of read-only attachers.
+// unlink() removes the name once every process is done.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace alikhan {
+
+namespace shm_detail {
+
+struct SegmentHeader {
+    char magic[4];                    // "AKSH"
+    std::uint32_t version;
+    std::uint64_t slot_capacity;      // bytes per slot
+    std::atomic<std::uint64_t> seq;   // odd while the writer flips
+    std::uint64_t active_slot;        // 0 or 1
+    std::uint64_t active_size;
+    std::uint64_t epoch;              // publish count; 0 = nothing yet
+};
+
+} // namespace shm_detail
+
+class ShmSegment {
+public:
+    ~ShmSegment() { close(); }
+
+    ShmSegment() = default;
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+
+    // Creates (or re-creates) the object `name` ("/alikhan-idx"
+    // style) sized for snapshots up to `slot_capacity` bytes. The
+    // creator is the writer.
+    bool create(const char* name, std::size_t slot_capacity) noexcept;
+
+    // Maps an existing segment read-only.
+    bool attach(const char* name) noexcept;
+
+    void close() noexcept;
+    static bool unlink(const char* name) noexcept;
+
+    bool is_open() const noexcept { return header_ != nullptr; }
+    std::size_t slot_capacity() const noexcept;
+
+    // Copies `size` snapshot bytes into the standby slot and
+    // publishes them. False with errno (EINVAL oversized, EACCES
+    // from an attacher).
+    bool publish(const void* data, std::size_t size) noexcept;
+
+    struct View {
+        const char* data = nullptr;
+        std::size_t size = 0;
+        std::uint64_t epoch = 0;
+    };
+
+    // Seqlock-consistent descriptor of the active snapshot; false
+    // until the first publish.
+    bool read(View& out) const noexcept;
+
+    // True while `v` still names a live slot (its epoch is at most
+    // one publish old).
+    bool validate(const View& v) const noexcept;
+
+    // Epoch of the latest publish, 0 before any.
+    std::uint64_t epoch() const noexcept;
+
+private:
+    shm_detail::SegmentHeader* header_ = nullptr;
+    char* slots_[2] = {nullptr, nullptr};
+    std::size_t map_size_ = 0;
+    bool writable_ = false;
+};
+
+} // namespace alikhan
@@ -0,0 +1,41 @@
+#pragma once
+
+// SIMD substring and delimiter-scan kernels.
+//
+// Drop-in replacements for the std::string_view find family on the
+// document-ingest hot path. Implementations are selected once at first
+// call by runtime CPU detection: AVX2 on x86-64 where available, NEON
+// on aarch64, with a portable scalar fallback everywhere else. All
+// functions return std::string_view::npos when nothing matches.
+//
+// The substring kernel uses the first/last-byte filter scheme: two
+// vector compares produce a candidate mask and only candidates are
+// verified with memcmp, so mismatching positions cost one vector
+// compare per 32 bytes rather than a scalar loop.
+
+#include <cstddef>
+#include <string_view>
+
+namespace alikhan {
+
+// First occurrence of `needle` in `hay`. Empty needles match at 0.
+std::size_t find(std::string_view hay, std::string_view needle) noexcept;
+
+// First occurrence of the byte `c` in `hay`.
+std::size_t find_byte(std::string_view hay, char c) noexcept;
+
+// First occurrence of any byte of `delims` in `hay` -- the delimiter
+// scan used by the tokenizer. `delims` is expected to be small (the
+// kernel broadcasts one vector per delimiter byte).
+std::size_t find_first_of(std::string_view hay, std::string_view delims) noexcept;
+
+namespace detail {
+// Exposed for alikhan_bench so individual implementations can be
+// measured against each other regardless of the host CPU.
+std::size_t find_scalar(std::string_view hay, std::string_view needle) noexcept;
+#if defined(__x86_64__)
+std::size_t find_avx2(std::string_view hay, std::string_view needle) noexcept;
+#endif
+} // namespace detail
+
+} // namespace alikhan
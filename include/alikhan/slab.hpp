@@ -0,0 +1,98 @@
+#pragma once
+
+// alikhan::SlabAlloc -- thread-local size-class allocator tier.
+//
+// Arena covers allocations that die together; cache entries and
+// index deltas allocate and free in arbitrary order and would
+// otherwise fall through to malloc. SlabAlloc gives each thread
+// power-of-two size-class bins (16..4096 bytes) carved from that
+// thread's own Arena blocks, so steady-state allocate/free is a
+// thread-local freelist push/pop with no lock and no global-
+// allocator traffic.
+//
+// Freeing from a different thread than the allocating one pushes the
+// block onto the owner's lock-free remote list (a CAS stack); the
+// owner absorbs that list the next time its local bin runs dry.
+// Requests above the largest class fall through to operator new.
+//
+// Each block carries an 8-byte header locating its bin, and returned
+// pointers are 8-byte aligned -- types needing stricter alignment
+// should take the operator-new path or an Arena. Memory retires in
+// bulk: blocks recycle through the freelists forever, and the
+// backing arenas release only when the SlabAlloc is destroyed, which
+// requires all blocks to be dead. The allocator must outlive every
+// thread that touches it, like an Executor.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace alikhan {
+
+class SlabAlloc {
+public:
+    static constexpr std::size_t kMinClass = 16;     // includes header
+    static constexpr std::size_t kMaxClass = 4096;
+    static constexpr std::size_t kClasses = 9;       // 16 << 0 .. 16 << 8
+
+    SlabAlloc();
+    ~SlabAlloc();
+
+    SlabAlloc(const SlabAlloc&) = delete;
+    SlabAlloc& operator=(const SlabAlloc&) = delete;
+
+    // Never returns nullptr for sizes the classes cover; large
+    // requests forward to operator new (which throws on exhaustion,
+    // matching container expectations).
+    void* allocate(std::size_t size);
+    void deallocate(void* p) noexcept;
+
+    // Largest user size served from the class bins.
+    static constexpr std::size_t max_small() noexcept {
+        return kMaxClass - sizeof(void*);
+    }
+
+    // Process-wide instance for containers without a better home.
+    static SlabAlloc& global();
+
+private:
+    struct ThreadCache;
+
+    ThreadCache& local_cache();
+
+    std::mutex reg_mu_;
+    std::vector<std::unique_ptr<ThreadCache>> caches_;
+};
+
+// Standard allocator adapter so node containers (the incremental
+// index's posting map, cache side tables) can sit on the slab tier:
+//
+//     std::map<K, V, std::less<>, SlabAllocator<std::pair<const K, V>>>
+//         m{SlabAllocator<std::pair<const K, V>>(alloc)};
+template <typename T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    explicit SlabAllocator(SlabAlloc& a) noexcept : alloc_(&a) {}
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>& o) noexcept : alloc_(o.alloc_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(alloc_->allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) noexcept { alloc_->deallocate(p); }
+
+    bool operator==(const SlabAllocator& o) const noexcept {
+        return alloc_ == o.alloc_;
+    }
+
+private:
+    template <typename U>
+    friend class SlabAllocator;
+    SlabAlloc* alloc_;
+};
+
+} // namespace alikhan
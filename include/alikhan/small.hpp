@@ -0,0 +1,200 @@
+#pragma once
+
+// Small-buffer containers for parsed records.
+//
+// Parsed fields are mostly short -- a skill token, a heading, a
+// handful of tokens per section -- and std::string/std::vector pay a
+// heap allocation for each one. SmallString<N> and SmallVec<T, N>
+// keep up to N bytes/elements in the object itself and spill to an
+// Arena only when a record is genuinely large, so the common case
+// allocates nothing and the rare case costs one bump-pointer hit.
+//
+// Spilled storage belongs to the arena: nothing is freed on
+// destruction or growth, and everything is reclaimed together by
+// Arena::reset(). That also makes moves trivial -- inline contents
+// are copied element-wise, spilled contents are a pointer steal.
+// Copying is deliberately not provided (a copy would need to name an
+// arena); pass records by reference or move them.
+//
+// An arena-less SmallVec (default-constructed) is a fixed-capacity
+// buffer: push_back returns false once the inline slots are full,
+// matching the try_push convention elsewhere in the library.
+
+#include "alikhan/arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <utility>
+
+namespace alikhan {
+
+template <std::size_t N>
+class SmallString {
+    static_assert(N >= sizeof(char*), "inline capacity below pointer size");
+
+public:
+    SmallString() noexcept : size_(0) {}
+
+    // Copies `s` inline if it fits, otherwise into `arena`.
+    SmallString(std::string_view s, Arena& arena) : SmallString() {
+        assign(s, arena);
+    }
+
+    SmallString(SmallString&& other) noexcept { steal(other); }
+
+    SmallString& operator=(SmallString&& other) noexcept {
+        if (this != &other) steal(other);
+        return *this;
+    }
+
+    SmallString(const SmallString&) = delete;
+    SmallString& operator=(const SmallString&) = delete;
+
+    void assign(std::string_view s, Arena& arena) {
+        if (s.size() <= N) {
+            std::memcpy(inline_, s.data(), s.size());
+        } else {
+            ptr_ = arena.dup(s.data(), s.size());
+        }
+        size_ = std::uint32_t(s.size());
+    }
+
+    const char* data() const noexcept { return is_inline() ? inline_ : ptr_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_inline() const noexcept { return size_ <= N; }
+
+    std::string_view view() const noexcept { return {data(), size_}; }
+    operator std::string_view() const noexcept { return view(); }
+
+    friend bool operator==(const SmallString& a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+
+private:
+    void steal(SmallString& other) noexcept {
+        if (other.is_inline())
+            std::memcpy(inline_, other.inline_, other.size_);
+        else
+            ptr_ = other.ptr_;
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    union {
+        char inline_[N];
+        const char* ptr_;       // arena copy when size_ > N
+    };
+    std::uint32_t size_;
+};
+
+template <typename T, std::size_t N>
+class SmallVec {
+public:
+    SmallVec() noexcept = default;
+
+    // Spills into `arena` when the inline slots run out.
+    explicit SmallVec(Arena& arena) noexcept : arena_(&arena) {}
+
+    SmallVec(SmallVec&& other) noexcept { steal(other); }
+
+    SmallVec& operator=(SmallVec&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            steal(other);
+        }
+        return *this;
+    }
+
+    SmallVec(const SmallVec&) = delete;
+    SmallVec& operator=(const SmallVec&) = delete;
+
+    ~SmallVec() { destroy(); }
+
+    // False only for an arena-less SmallVec whose inline slots are
+    // full; with an arena, push_back always succeeds.
+    bool push_back(const T& v) { return emplace_back(v); }
+    bool push_back(T&& v) { return emplace_back(std::move(v)); }
+
+    template <typename... Args>
+    bool emplace_back(Args&&... args) {
+        if (size_ == cap_ && !grow()) return false;
+        ::new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    T* begin() noexcept { return data_; }
+    T* end() noexcept { return data_ + size_; }
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size_; }
+
+    T& operator[](std::size_t i) noexcept { return data_[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+    T& back() noexcept { return data_[size_ - 1]; }
+
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return cap_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_inline() const noexcept {
+        return data_ == reinterpret_cast<const T*>(inline_);
+    }
+
+    // Destroys elements; storage (inline or the current arena block)
+    // is kept for reuse.
+    void clear() noexcept {
+        for (std::size_t i = 0; i < size_; ++i) data_[i].~T();
+        size_ = 0;
+    }
+
+private:
+    bool grow() {
+        if (arena_ == nullptr) return false;
+        const std::size_t new_cap = cap_ * 2;
+        T* fresh = static_cast<T*>(
+            arena_->allocate(new_cap * sizeof(T), alignof(T)));
+        for (std::size_t i = 0; i < size_; ++i) {
+            ::new (fresh + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        // The old spill block stays in the arena until reset().
+        data_ = fresh;
+        cap_ = new_cap;
+        return true;
+    }
+
+    void steal(SmallVec& other) noexcept {
+        arena_ = other.arena_;
+        size_ = other.size_;
+        if (other.is_inline()) {
+            data_ = reinterpret_cast<T*>(inline_);
+            cap_ = N;
+            for (std::size_t i = 0; i < size_; ++i) {
+                ::new (data_ + i) T(std::move(other.data_[i]));
+                other.data_[i].~T();
+            }
+        } else {
+            data_ = other.data_;
+            cap_ = other.cap_;
+            other.data_ = reinterpret_cast<T*>(other.inline_);
+            other.cap_ = N;
+        }
+        other.size_ = 0;
+    }
+
+    void destroy() noexcept {
+        for (std::size_t i = 0; i < size_; ++i) data_[i].~T();
+    }
+
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    T* data_ = reinterpret_cast<T*>(inline_);
+    std::size_t size_ = 0;
+    std::size_t cap_ = N;
+    Arena* arena_ = nullptr;
+};
+
+} // namespace alikhan
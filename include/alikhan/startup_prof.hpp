@@ -0,0 +1,124 @@
+#pragma once
+
+// Startup-cost instrumentation and lazy static initialization.
+//
+// CLI tools built on alikhan need cold start under ~10 ms, so every
+// static initializer and first-use table build in the library is
+// accounted for. Two pieces:
+//
+//   * record_startup_cost / StartupTimer / AK_TIMED_INIT tag a named
+//     cost into a process-wide registry; write_startup_report() dumps
+//     it in the bench_output.txt record style (name, ns) so the same
+//     tooling that gates benchmarks can gate startup.
+//
+//   * Lazy<T> defers construction to first use. Library tables (e.g.
+//     perfect-hash keyword sets built at runtime) should live behind
+//     Lazy so binaries that never touch them never pay for them; the
+//     construction cost is recorded automatically under the lazy
+//     value's name.
+//
+// The registry itself is a function-local static, so it is safe to
+// record from any static initializer regardless of TU order.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace alikhan {
+
+struct StartupRecord {
+    const char* name;      // must outlive the process (string literal)
+    std::uint64_t ns;
+};
+
+// Appends one record; thread-safe, callable during static init.
+void record_startup_cost(const char* name, std::uint64_t ns);
+
+// Snapshot of everything recorded so far.
+std::vector<StartupRecord> startup_records();
+
+// Writes "name<TAB>ns" lines, one per record, in recording order.
+// Returns false with errno set on I/O failure.
+bool write_startup_report(const char* path);
+
+// RAII scope timer feeding record_startup_cost.
+class StartupTimer {
+public:
+    explicit StartupTimer(const char* name) noexcept
+        : name_(name), start_(std::chrono::steady_clock::now()) {}
+    ~StartupTimer() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start_)
+                            .count();
+        record_startup_cost(name_, std::uint64_t(ns));
+    }
+    StartupTimer(const StartupTimer&) = delete;
+    StartupTimer& operator=(const StartupTimer&) = delete;
+
+private:
+    const char* name_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Wraps a static initializer expression so its cost lands in the
+// report: static auto kTable = AK_TIMED_INIT("kTable", build_table());
+#define AK_TIMED_INIT(name, ...)                      \
+    []() {                                            \
+        ::alikhan::StartupTimer ak_timed_init_(name); \
+        return (__VA_ARGS__);                         \
+    }()
+
+// Lazily constructed value with first-use cost recording. Factory is
+// any callable returning T; construction happens at most once, under
+// double-checked locking, on the first get().
+template <typename T, typename Factory = T (*)()>
+class Lazy {
+public:
+    constexpr Lazy(const char* name, Factory factory) noexcept
+        : name_(name), factory_(std::move(factory)) {}
+
+    ~Lazy() {
+        if (ready_.load(std::memory_order_acquire)) value_ptr()->~T();
+    }
+
+    Lazy(const Lazy&) = delete;
+    Lazy& operator=(const Lazy&) = delete;
+
+    T& get() {
+        if (!ready_.load(std::memory_order_acquire)) [[unlikely]]
+            construct();
+        return *value_ptr();
+    }
+
+    T& operator*() { return get(); }
+    T* operator->() { return &get(); }
+
+    bool constructed() const noexcept {
+        return ready_.load(std::memory_order_acquire);
+    }
+
+private:
+    void construct() {
+        std::lock_guard<std::mutex> lock(init_mu_);
+        if (ready_.load(std::memory_order_relaxed)) return;
+        {
+            StartupTimer timer(name_);
+            ::new (&storage_) T(factory_());
+        }
+        ready_.store(true, std::memory_order_release);
+    }
+
+    T* value_ptr() noexcept { return std::launder(reinterpret_cast<T*>(&storage_)); }
+
+    const char* name_;
+    Factory factory_;
+    std::mutex init_mu_;
+    std::atomic<bool> ready_{false};
+    alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+} // namespace alikhan
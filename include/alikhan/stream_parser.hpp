@@ -0,0 +1,69 @@
+#pragma once
+
+// alikhan::StreamParser -- incremental parse over fixed-size chunks.
+//
+// ResumeParser wants the whole document mapped; concatenated archive
+// dumps are tens of GB and must be parsed in O(chunk) memory instead.
+// StreamParser consumes chunks as they arrive (typically IoEngine
+// buffers) and emits the same logical stream -- section starts and
+// word tokens -- as a pull API:
+//
+//     StreamParser sp;
+//     for (each chunk) {
+//         sp.feed(chunk);
+//         while (sp.next(ev)) consume(ev);
+//     }
+//     sp.finish();
+//     while (sp.next(ev)) consume(ev);
+//
+// Only complete lines are parsed, so a token or heading split across
+// a chunk boundary is carried in a small internal buffer and emitted
+// once its line completes; memory use is bounded by the longest input
+// line, not the document. Event text views point either into the fed
+// chunk (valid until the next feed()) or into the carry buffer (valid
+// until the following next()), so consume events before feeding more.
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace alikhan {
+
+class StreamParser {
+public:
+    enum class EventType {
+        SectionStart,   // text = heading, level = number of '#'s
+        Token,          // text = word token
+    };
+
+    struct Event {
+        EventType type;
+        std::string_view text;
+        int level = 0;
+    };
+
+    // Hands the parser the next chunk. All events from the previous
+    // chunk must have been pulled (next() returned false).
+    void feed(std::string_view chunk);
+
+    // Signals end of input so a trailing unterminated line is parsed.
+    void finish();
+
+    // Pulls the next event; false when the current chunk is exhausted
+    // (feed more, or finish() then drain).
+    bool next(Event& out);
+
+private:
+    bool take_line();               // advances line_ to the next complete line
+
+    std::string_view chunk_;        // unconsumed part of the fed chunk
+    std::string carry_;             // partial trailing line across chunks
+    std::string line_buf_;          // completed carry line being emitted
+    std::string_view line_;         // unconsumed part of the current line
+    bool line_is_heading_ = false;
+    int heading_level_ = 0;
+    bool heading_pending_ = false;
+    bool finished_ = false;
+};
+
+} // namespace alikhan
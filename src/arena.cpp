@@ -0,0 +1,133 @@
+#include "alikhan/arena.hpp"
+
+#include <cstdlib>
+#include <sys/mman.h>
+
+namespace alikhan {
+
+namespace {
+
+// Reserves `total` bytes for a huge-page block. MAP_HUGETLB needs
+// pre-reserved pool pages and fails outright without them, so the
+// fallback over-maps by one huge page, trims to 2 MiB alignment, and
+// asks THP to back the result.
+void* map_huge(std::size_t total, Arena::HugePages mode,
+               std::size_t& map_len) noexcept {
+    constexpr std::size_t kHuge = Arena::kHugePageSize;
+    if (mode == Arena::HugePages::Explicit) {
+        void* p = ::mmap(nullptr, total, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            map_len = total;
+            return p;
+        }
+    }
+    const std::size_t over = total + kHuge;
+    char* raw = static_cast<char*>(::mmap(nullptr, over, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (raw == MAP_FAILED) return nullptr;
+    const std::uintptr_t base =
+        (reinterpret_cast<std::uintptr_t>(raw) + kHuge - 1) & ~(kHuge - 1);
+    char* aligned = reinterpret_cast<char*>(base);
+    if (aligned != raw) ::munmap(raw, std::size_t(aligned - raw));
+    const std::size_t tail = over - std::size_t(aligned - raw) - total;
+    if (tail != 0) ::munmap(aligned + total, tail);
+    ::madvise(aligned, total, MADV_HUGEPAGE);
+    map_len = total;
+    return aligned;
+}
+
+} // namespace
+
+Arena::Block* Arena::new_block(std::size_t min_size) {
+    // Grow geometrically so long-lived arenas amortize to O(log n)
+    // malloc calls, but never carve a block smaller than the request.
+    std::size_t want = block_size_;
+    if (head_ != nullptr && head_->size < (std::size_t{1} << 26))
+        want = head_->size * 2;
+    if (want < min_size) want = min_size;
+
+    void* raw = nullptr;
+    std::size_t map_len = 0;
+    if (huge_ != HugePages::Off &&
+        offsetof(Block, data) + want >= kHugePageSize) {
+        const std::size_t total =
+            (offsetof(Block, data) + want + kHugePageSize - 1) &
+            ~(kHugePageSize - 1);
+        raw = map_huge(total, huge_, map_len);
+        if (raw != nullptr) want = total - offsetof(Block, data);
+    }
+    if (raw == nullptr)
+        raw = ::operator new(offsetof(Block, data) + want);
+    Block* b = static_cast<Block*>(raw);
+    b->next = head_;
+    b->size = want;
+    b->map_len = map_len;
+    head_ = b;
+    return b;
+}
+
+void Arena::free_block(Block* b) noexcept {
+    if (b->map_len != 0)
+        ::munmap(b, b->map_len);
+    else
+        ::operator delete(b);
+}
+
+void* Arena::allocate_slow(std::size_t size, std::size_t align) {
+    // Oversized requests get a dedicated block and leave the current
+    // bump region alone, so one huge allocation does not strand the
+    // tail of an active block.
+    if (size + align > block_size_ && cur_ != end_) {
+        Block* big = new_block(size + align);
+        // new_block pushed `big` in front of the active block; the
+        // cursor still points into the old one, which is what we want.
+        std::uintptr_t p = reinterpret_cast<std::uintptr_t>(big->data);
+        p = (p + (align - 1)) & ~(align - 1);
+        bytes_used_ += size;
+        // Keep the active block reachable: swap `big` behind it.
+        head_ = big->next;
+        big->next = head_->next;
+        head_->next = big;
+        return reinterpret_cast<void*>(p);
+    }
+
+    Block* b = new_block(size + align);
+    cur_ = b->data;
+    end_ = b->data + b->size;
+    std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(cur_) + (align - 1)) & ~(align - 1);
+    cur_ = reinterpret_cast<char*>(p + size);
+    bytes_used_ += size;
+    return reinterpret_cast<void*>(p);
+}
+
+void Arena::reset() noexcept {
+    if (head_ == nullptr) return;
+    // Free every block but the newest, which becomes the fresh bump
+    // region; steady-state reuse then never re-enters the allocator.
+    Block* keep = head_;
+    Block* b = keep->next;
+    while (b != nullptr) {
+        Block* next = b->next;
+        free_block(b);
+        b = next;
+    }
+    keep->next = nullptr;
+    cur_ = keep->data;
+    end_ = keep->data + keep->size;
+    bytes_used_ = 0;
+}
+
+void Arena::release() noexcept {
+    Block* b = head_;
+    while (b != nullptr) {
+        Block* next = b->next;
+        free_block(b);
+        b = next;
+    }
+    head_ = nullptr;
+    cur_ = end_ = nullptr;
+    bytes_used_ = 0;
+}
+
+} // namespace alikhan
@@ -0,0 +1,379 @@
+#include "alikhan/codec.hpp"
+
+#include "alikhan/arena.hpp"
+#include "alikhan/intern.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace alikhan {
+namespace codec {
+
+namespace {
+
+std::uint64_t align8(std::uint64_t v) noexcept { return (v + 7) & ~7ull; }
+
+std::size_t packed_words(std::size_t n, unsigned bits) noexcept {
+    return (n * bits + 63) / 64;
+}
+
+unsigned bits_for(std::uint64_t max_delta) noexcept {
+    return max_delta == 0 ? 0 : 64u - unsigned(__builtin_clzll(max_delta));
+}
+
+// Packs n values (already reduced to deltas) at `bits` per value into
+// little-endian 64-bit words.
+void pack_block(const std::uint64_t* v, std::size_t n, unsigned bits,
+                std::uint64_t* out) noexcept {
+    if (bits == 0) return;
+    std::uint64_t acc = 0;
+    unsigned fill = 0;
+    std::size_t w = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc |= v[i] << fill;
+        fill += bits;
+        if (fill >= 64) {
+            out[w++] = acc;
+            fill -= 64;
+            acc = fill != 0 ? v[i] >> (bits - fill) : 0;
+        }
+    }
+    if (fill != 0) out[w] = acc;
+}
+
+void unpack_block_scalar(const std::uint64_t* in, std::size_t n, unsigned bits,
+                         std::uint64_t ref, std::uint64_t* out) noexcept {
+    const std::uint64_t mask =
+        bits >= 64 ? ~0ull : (std::uint64_t(1) << bits) - 1;
+    std::size_t w = 0;
+    unsigned off = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t v = in[w] >> off;
+        if (off + bits > 64) v |= in[w + 1] << (64 - off);
+        out[i] = (v & mask) + ref;
+        off += bits;
+        if (off >= 64) {
+            off -= 64;
+            ++w;
+        }
+    }
+}
+
+#if defined(__x86_64__)
+
+// Byte-aligned widths unpack with widening loads; other widths take
+// the scalar shift pipeline, which the per-block L1 footprint keeps
+// cheap anyway.
+__attribute__((target("avx2"))) void unpack_block_avx2(
+    const std::uint64_t* in, std::size_t n, unsigned bits, std::uint64_t ref,
+    std::uint64_t* out) noexcept {
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(in);
+    const __m256i vref = _mm256_set1_epi64x(std::int64_t(ref));
+    std::size_t i = 0;
+    if (bits == 8) {
+        for (; i + 4 <= n; i += 4) {
+            const __m256i v = _mm256_cvtepu8_epi64(
+                _mm_loadu_si32(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_add_epi64(v, vref));
+        }
+    } else if (bits == 16) {
+        for (; i + 4 <= n; i += 4) {
+            const __m256i v = _mm256_cvtepu16_epi64(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 2)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_add_epi64(v, vref));
+        }
+    } else {   // bits == 32
+        for (; i + 4 <= n; i += 4) {
+            const __m256i v = _mm256_cvtepu32_epi64(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_add_epi64(v, vref));
+        }
+    }
+    for (; i < n; ++i) {
+        std::uint64_t v;
+        if (bits == 8) v = src[i];
+        else if (bits == 16) std::memcpy(&v, src + i * 2, 2), v &= 0xFFFF;
+        else std::memcpy(&v, src + i * 4, 4), v &= 0xFFFFFFFF;
+        out[i] = v + ref;
+    }
+}
+
+#endif // __x86_64__
+
+void unpack_block(const std::uint64_t* in, std::size_t n, unsigned bits,
+                  std::uint64_t ref, std::uint64_t* out) noexcept {
+    if (bits == 0) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = ref;
+        return;
+    }
+#if defined(__x86_64__)
+    if (bits == 8 || bits == 16 || bits == 32) {
+        static const bool have_avx2 = __builtin_cpu_supports("avx2");
+        if (have_avx2) {
+            unpack_block_avx2(in, n, bits, ref, out);
+            return;
+        }
+    }
+#endif
+    unpack_block_scalar(in, n, bits, ref, out);
+}
+
+void append(std::vector<char>& out, const void* p, std::size_t n) {
+    const char* c = static_cast<const char*>(p);
+    out.insert(out.end(), c, c + n);
+}
+
+void pad8(std::vector<char>& out, std::size_t base) {
+    while ((out.size() - base) % 8 != 0) out.push_back(0);
+}
+
+// Shared encode core over u64 block deltas; the u32 entry point
+// widens each block into a stack staging buffer first.
+void for_encode_blocks(const std::uint64_t* values, std::size_t n,
+                       std::vector<char>& out,
+                       const std::uint32_t* narrow_values) {
+    const std::size_t base = out.size();
+    const std::uint32_t nblocks =
+        std::uint32_t((n + kForBlock - 1) / kForBlock);
+    const std::uint32_t zero = 0;
+    append(out, &nblocks, 4);
+    append(out, &zero, 4);
+    const std::size_t off_table = out.size();
+    out.resize(out.size() + (nblocks + 1) * 4);
+    pad8(out, base);
+
+    std::uint64_t block[kForBlock];
+    std::uint32_t running = 0;   // bytes into the block area
+    for (std::uint32_t b = 0; b < nblocks; ++b) {
+        const std::size_t lo = std::size_t(b) * kForBlock;
+        const std::size_t nv = std::min(kForBlock, n - lo);
+        if (narrow_values != nullptr)
+            for (std::size_t i = 0; i < nv; ++i)
+                block[i] = narrow_values[lo + i];
+        else
+            std::memcpy(block, values + lo, nv * sizeof(std::uint64_t));
+
+        std::uint64_t ref = block[0];
+        for (std::size_t i = 1; i < nv; ++i) ref = std::min(ref, block[i]);
+        std::uint64_t max_delta = 0;
+        for (std::size_t i = 0; i < nv; ++i) {
+            block[i] -= ref;
+            max_delta = std::max(max_delta, block[i]);
+        }
+        const unsigned bits = bits_for(max_delta);
+        const std::size_t words = packed_words(nv, bits);
+
+        std::memcpy(out.data() + off_table + b * 4, &running, 4);
+        append(out, &ref, 8);
+        const std::uint64_t bits_field = bits;   // u8 + 7 pad bytes
+        append(out, &bits_field, 8);
+        const std::size_t word_pos = out.size();
+        out.resize(out.size() + words * 8, 0);
+        pack_block(block, nv, bits,
+                   reinterpret_cast<std::uint64_t*>(out.data() + word_pos));
+        running += std::uint32_t(16 + words * 8);
+    }
+    std::memcpy(out.data() + off_table + std::size_t(nblocks) * 4, &running, 4);
+}
+
+struct ForView {
+    const std::uint32_t* block_off;
+    const char* blocks;
+    std::uint32_t nblocks;
+
+    bool init(const void* data, std::size_t size, std::size_t n) noexcept {
+        if (size < 8) return false;
+        const char* base = static_cast<const char*>(data);
+        std::memcpy(&nblocks, base, 4);
+        if (nblocks != (n + kForBlock - 1) / kForBlock) return false;
+        const std::size_t table_end = 8 + (std::size_t(nblocks) + 1) * 4;
+        const std::size_t blocks_at = align8(table_end);
+        if (blocks_at > size) return false;
+        block_off = reinterpret_cast<const std::uint32_t*>(base + 8);
+        blocks = base + blocks_at;
+        return blocks_at + block_off[nblocks] <= size;
+    }
+
+    void block(std::uint32_t b, std::uint64_t& ref, unsigned& bits,
+               const std::uint64_t*& words) const noexcept {
+        const char* p = blocks + block_off[b];
+        std::memcpy(&ref, p, 8);
+        bits = static_cast<unsigned char>(p[8]);
+        words = reinterpret_cast<const std::uint64_t*>(p + 16);
+    }
+};
+
+} // namespace
+
+void for_encode_u64(const std::uint64_t* values, std::size_t n,
+                    std::vector<char>& out) {
+    for_encode_blocks(values, n, out, nullptr);
+}
+
+void for_encode_u32(const std::uint32_t* values, std::size_t n,
+                    std::vector<char>& out) {
+    for_encode_blocks(nullptr, n, out, values);
+}
+
+bool for_decode_u64(const void* data, std::size_t size, std::size_t n,
+                    std::uint64_t* out) noexcept {
+    if (n == 0) return true;
+    ForView v;
+    if (!v.init(data, size, n)) return false;
+    for (std::uint32_t b = 0; b < v.nblocks; ++b) {
+        const std::size_t lo = std::size_t(b) * kForBlock;
+        const std::size_t nv = std::min(kForBlock, n - lo);
+        std::uint64_t ref;
+        unsigned bits;
+        const std::uint64_t* words;
+        v.block(b, ref, bits, words);
+        if (bits > 64) return false;
+        unpack_block(words, nv, bits, ref, out + lo);
+    }
+    return true;
+}
+
+bool for_decode_u32(const void* data, std::size_t size, std::size_t n,
+                    std::uint32_t* out) noexcept {
+    if (n == 0) return true;
+    ForView v;
+    if (!v.init(data, size, n)) return false;
+    std::uint64_t wide[kForBlock];
+    for (std::uint32_t b = 0; b < v.nblocks; ++b) {
+        const std::size_t lo = std::size_t(b) * kForBlock;
+        const std::size_t nv = std::min(kForBlock, n - lo);
+        std::uint64_t ref;
+        unsigned bits;
+        const std::uint64_t* words;
+        v.block(b, ref, bits, words);
+        if (bits > 64) return false;
+        unpack_block(words, nv, bits, ref, wide);
+        for (std::size_t i = 0; i < nv; ++i)
+            out[lo + i] = std::uint32_t(wide[i]);
+    }
+    return true;
+}
+
+std::uint64_t for_get(const void* data, std::size_t row) noexcept {
+    const char* base = static_cast<const char*>(data);
+    std::uint32_t nblocks;
+    std::memcpy(&nblocks, base, 4);
+    const std::uint32_t* off =
+        reinterpret_cast<const std::uint32_t*>(base + 8);
+    const char* blocks =
+        base + align8(8 + (std::size_t(nblocks) + 1) * 4);
+    const char* p = blocks + off[row / kForBlock];
+    std::uint64_t ref;
+    std::memcpy(&ref, p, 8);
+    const unsigned bits = static_cast<unsigned char>(p[8]);
+    if (bits == 0) return ref;
+    const std::uint64_t* words =
+        reinterpret_cast<const std::uint64_t*>(p + 16);
+    const std::size_t bit_pos = (row % kForBlock) * bits;
+    std::uint64_t v = words[bit_pos / 64] >> (bit_pos % 64);
+    if (bit_pos % 64 + bits > 64)
+        v |= words[bit_pos / 64 + 1] << (64 - bit_pos % 64);
+    const std::uint64_t mask =
+        bits >= 64 ? ~0ull : (std::uint64_t(1) << bits) - 1;
+    return (v & mask) + ref;
+}
+
+void dict_encode(const std::string_view* values, std::size_t n,
+                 std::vector<char>& out) {
+    // Intern every spelling to get dense first-seen ids.
+    Arena arena(1 << 16);
+    InternPool pool(arena);
+    std::vector<std::uint32_t> ids(n);
+    for (std::size_t i = 0; i < n; ++i) ids[i] = pool.intern(values[i]);
+
+    const std::uint32_t dict_count = std::uint32_t(pool.size());
+    const std::uint32_t id_bits =
+        dict_count <= 1 ? 0 : bits_for(dict_count - 1);
+
+    const std::size_t base = out.size();
+    append(out, &dict_count, 4);
+    append(out, &id_bits, 4);
+    std::uint32_t off = 0;
+    for (std::uint32_t s = 0; s < dict_count; ++s) {
+        append(out, &off, 4);
+        off += std::uint32_t(pool.text(s).size());
+    }
+    append(out, &off, 4);
+    for (std::uint32_t s = 0; s < dict_count; ++s) {
+        const std::string_view t = pool.text(s);
+        append(out, t.data(), t.size());
+    }
+    pad8(out, base);
+
+    if (id_bits != 0) {
+        const std::size_t word_pos = out.size();
+        out.resize(out.size() + packed_words(n, id_bits) * 8, 0);
+        std::uint64_t block[kForBlock];
+        // pack_block flushes whole words, so feed it kForBlock-sized
+        // runs only on word-aligned boundaries (kForBlock * bits is a
+        // multiple of 64 for every width).
+        std::uint64_t* words =
+            reinterpret_cast<std::uint64_t*>(out.data() + word_pos);
+        for (std::size_t lo = 0; lo < n; lo += kForBlock) {
+            const std::size_t nv = std::min(kForBlock, n - lo);
+            for (std::size_t i = 0; i < nv; ++i) block[i] = ids[lo + i];
+            pack_block(block, nv, id_bits,
+                       words + packed_words(lo, id_bits));
+        }
+    }
+}
+
+bool DictView::init(const void* data, std::size_t size,
+                    std::size_t rows) noexcept {
+    if (size < 8) return false;
+    const char* base = static_cast<const char*>(data);
+    std::memcpy(&dict_count_, base, 4);
+    std::memcpy(&id_bits_, base + 4, 4);
+    if (id_bits_ > 32) return false;
+    const std::size_t off_at = 8;
+    const std::size_t blob_at = off_at + (std::size_t(dict_count_) + 1) * 4;
+    if (blob_at > size) return false;
+    dict_off_ = reinterpret_cast<const std::uint32_t*>(base + off_at);
+    if (dict_count_ != 0 && blob_at + dict_off_[dict_count_] > size)
+        return false;
+    blob_ = base + blob_at;
+    const std::size_t words_at =
+        align8(blob_at + (dict_count_ != 0 ? dict_off_[dict_count_] : 0));
+    if (words_at + packed_words(rows, id_bits_) * 8 > size) return false;
+    words_ = reinterpret_cast<const std::uint64_t*>(base + words_at);
+    rows_ = rows;
+    return true;
+}
+
+std::uint32_t DictView::id_at(std::size_t row) const noexcept {
+    if (id_bits_ == 0) return 0;
+    const std::size_t bit_pos = row * id_bits_;
+    std::uint64_t v = words_[bit_pos / 64] >> (bit_pos % 64);
+    if (bit_pos % 64 + id_bits_ > 64)
+        v |= words_[bit_pos / 64 + 1] << (64 - bit_pos % 64);
+    return std::uint32_t(v & ((std::uint64_t(1) << id_bits_) - 1));
+}
+
+void DictView::decode_ids(std::uint32_t* out) const noexcept {
+    if (id_bits_ == 0) {
+        std::memset(out, 0, rows_ * sizeof(std::uint32_t));
+        return;
+    }
+    std::uint64_t wide[kForBlock];
+    for (std::size_t lo = 0; lo < rows_; lo += kForBlock) {
+        const std::size_t nv = std::min(kForBlock, rows_ - lo);
+        unpack_block(words_ + packed_words(lo, id_bits_), nv, id_bits_, 0,
+                     wide);
+        for (std::size_t i = 0; i < nv; ++i)
+            out[lo + i] = std::uint32_t(wide[i]);
+    }
+}
+
+} // namespace codec
+} // namespace alikhan
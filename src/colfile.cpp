@@ -0,0 +1,255 @@
+#include "alikhan/colfile.hpp"
+
+#include <cerrno>
+#include <cstdio>
+
+namespace alikhan {
+
+using namespace colfile_detail;
+
+bool ColumnFile::bind(const char* data, std::size_t size) noexcept {
+    if (size < sizeof(FileHeader)) {
+        errno = EINVAL;
+        return false;
+    }
+    const auto* h = reinterpret_cast<const FileHeader*>(data);
+    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 ||
+        h->version != kVersion ||
+        h->desc_offset + std::uint64_t(h->column_count) * sizeof(ColumnDesc) >
+            size) {
+        errno = EINVAL;
+        return false;
+    }
+    base_ = data;
+    header_ = h;
+    descs_ = reinterpret_cast<const ColumnDesc*>(data + h->desc_offset);
+    return true;
+}
+
+bool ColumnFile::open(const char* path) noexcept {
+    close();
+    if (!map_.open(path)) return false;
+    if (!bind(map_.data(), map_.size())) {
+        map_.close();
+        return false;
+    }
+    // A huge-aligned layout advertises itself by its first section
+    // offset; ask for THP backing so big snapshots scan with 2 MiB
+    // TLB entries. Advisory -- a kernel that refuses costs nothing.
+    if (header_->column_count > 0) {
+        const auto& d0 = descs_[0];
+        const std::uint64_t first =
+            d0.aux_size != 0 ? d0.aux_offset : d0.data_offset;
+        if (first != 0 && first % kHugeSectionAlign == 0)
+            map_.advise(MappedFile::Advice::Huge);
+    }
+    return true;
+}
+
+bool ColumnFile::open_bytes(const char* data, std::size_t size) noexcept {
+    close();
+    return bind(data, size);
+}
+
+bool ColumnView::decode_u64(std::uint64_t* out) const noexcept {
+    if (type() != ColumnType::U32 && type() != ColumnType::U64) return false;
+    if (codec() == ColumnCodec::FrameOfRef)
+        return codec::for_decode_u64(base_ + desc_->data_offset,
+                                     desc_->data_size, rows_, out);
+    if (codec() != ColumnCodec::Raw) return false;
+    if (type() == ColumnType::U64) {
+        std::memcpy(out, data<std::uint64_t>(), rows_ * sizeof(std::uint64_t));
+    } else {
+        const std::uint32_t* in = data<std::uint32_t>();
+        for (std::uint64_t i = 0; i < rows_; ++i) out[i] = in[i];
+    }
+    return true;
+}
+
+bool ColumnView::decode_u32(std::uint32_t* out) const noexcept {
+    if (type() != ColumnType::U32) return false;
+    if (codec() == ColumnCodec::FrameOfRef)
+        return codec::for_decode_u32(base_ + desc_->data_offset,
+                                     desc_->data_size, rows_, out);
+    if (codec() != ColumnCodec::Raw) return false;
+    std::memcpy(out, data<std::uint32_t>(), rows_ * sizeof(std::uint32_t));
+    return true;
+}
+
+bool ColumnView::dict(codec::DictView& out) const noexcept {
+    if (codec() != ColumnCodec::Dict) return false;
+    return out.init(base_ + desc_->data_offset, desc_->data_size, rows_);
+}
+
+std::string_view ColumnView::dict_bytes(std::uint64_t row) const noexcept {
+    codec::DictView dv;
+    if (!dv.init(base_ + desc_->data_offset, desc_->data_size, rows_))
+        return {};
+    return dv.at(row);
+}
+
+ColumnView ColumnFile::column(std::string_view name) const noexcept {
+    for (std::uint32_t i = 0; i < header_->column_count; ++i)
+        if (name == descs_[i].name) return column(i);
+    return {};
+}
+
+void ColumnFileWriter::add_u32(std::string_view name, const std::uint32_t* values,
+                               std::size_t n, ColumnCodec codec) {
+    PendingColumn col;
+    col.name.assign(name.substr(0, kMaxNameLen));
+    col.type = ColumnType::U32;
+    col.rows = n;
+    if (codec == ColumnCodec::FrameOfRef && n != 0) {
+        col.codec = codec;
+        codec::for_encode_u32(values, n, col.data);
+    } else {
+        col.data.assign(reinterpret_cast<const char*>(values),
+                        reinterpret_cast<const char*>(values) + n * sizeof(*values));
+    }
+    columns_.push_back(std::move(col));
+}
+
+void ColumnFileWriter::add_u64(std::string_view name, const std::uint64_t* values,
+                               std::size_t n, ColumnCodec codec) {
+    PendingColumn col;
+    col.name.assign(name.substr(0, kMaxNameLen));
+    col.type = ColumnType::U64;
+    col.rows = n;
+    if (codec == ColumnCodec::FrameOfRef && n != 0) {
+        col.codec = codec;
+        codec::for_encode_u64(values, n, col.data);
+    } else {
+        col.data.assign(reinterpret_cast<const char*>(values),
+                        reinterpret_cast<const char*>(values) + n * sizeof(*values));
+    }
+    columns_.push_back(std::move(col));
+}
+
+void ColumnFileWriter::add_f64(std::string_view name, const double* values,
+                               std::size_t n) {
+    PendingColumn col;
+    col.name.assign(name.substr(0, kMaxNameLen));
+    col.type = ColumnType::F64;
+    col.rows = n;
+    col.data.assign(reinterpret_cast<const char*>(values),
+                    reinterpret_cast<const char*>(values) + n * sizeof(*values));
+    columns_.push_back(std::move(col));
+}
+
+void ColumnFileWriter::add_bytes(std::string_view name,
+                                 const std::string_view* values, std::size_t n,
+                                 ColumnCodec codec) {
+    PendingColumn col;
+    col.name.assign(name.substr(0, kMaxNameLen));
+    col.type = ColumnType::Bytes;
+    col.rows = n;
+    if (codec == ColumnCodec::Dict && n != 0) {
+        col.codec = codec;
+        codec::dict_encode(values, n, col.data);
+        columns_.push_back(std::move(col));
+        return;
+    }
+    col.offsets.reserve(n + 1);
+    std::uint32_t off = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        col.offsets.push_back(off);
+        col.data.insert(col.data.end(), values[i].begin(), values[i].end());
+        off += std::uint32_t(values[i].size());
+    }
+    col.offsets.push_back(off);
+    columns_.push_back(std::move(col));
+}
+
+namespace {
+
+std::uint64_t align_up(std::uint64_t v, std::uint64_t a) noexcept {
+    return (v + a - 1) & ~(a - 1);
+}
+
+bool pad_to(std::FILE* f, std::uint64_t target, std::uint64_t& pos) noexcept {
+    static const char zeros[kSectionAlign] = {};
+    while (pos < target) {
+        const std::size_t n = std::size_t(target - pos) < sizeof(zeros)
+                                  ? std::size_t(target - pos)
+                                  : sizeof(zeros);
+        if (std::fwrite(zeros, 1, n, f) != n) return false;
+        pos += n;
+    }
+    return true;
+}
+
+} // namespace
+
+bool ColumnFileWriter::write(const char* path) const noexcept {
+    std::uint64_t rows = columns_.empty() ? 0 : columns_.front().rows;
+    for (const auto& c : columns_)
+        if (c.rows != rows) {
+            errno = EINVAL;
+            return false;
+        }
+
+    // Lay out sections first so descriptors can be emitted in one pass.
+    std::vector<ColumnDesc> descs(columns_.size());
+    std::uint64_t pos = sizeof(FileHeader);
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        const auto& c = columns_[i];
+        ColumnDesc& d = descs[i];
+        std::memset(&d, 0, sizeof(d));
+        std::memcpy(d.name, c.name.data(), c.name.size());
+        d.type = std::uint16_t(c.type);
+        d.codec = std::uint16_t(c.codec);
+        if (!c.offsets.empty()) {
+            pos = align_up(pos, section_align_);
+            d.aux_offset = pos;
+            d.aux_size = c.offsets.size() * sizeof(std::uint32_t);
+            pos += d.aux_size;
+        }
+        pos = align_up(pos, section_align_);
+        d.data_offset = pos;
+        d.data_size = c.data.size();
+        pos += d.data_size;
+    }
+    const std::uint64_t desc_offset = align_up(pos, section_align_);
+
+    FileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.column_count = std::uint32_t(columns_.size());
+    h.row_count = rows;
+    h.desc_offset = desc_offset;
+
+    std::FILE* f = std::fopen(path, "wb");
+    if (f == nullptr) return false;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    std::uint64_t written = sizeof(h);
+    for (std::size_t i = 0; ok && i < columns_.size(); ++i) {
+        const auto& c = columns_[i];
+        const auto& d = descs[i];
+        if (!c.offsets.empty()) {
+            ok = pad_to(f, d.aux_offset, written) &&
+                 std::fwrite(c.offsets.data(), 1, d.aux_size, f) == d.aux_size;
+            written += d.aux_size;
+        }
+        if (ok) {
+            ok = pad_to(f, d.data_offset, written) &&
+                 (c.data.empty() ||
+                  std::fwrite(c.data.data(), 1, c.data.size(), f) == c.data.size());
+            written += c.data.size();
+        }
+    }
+    if (ok && !descs.empty()) {
+        ok = pad_to(f, desc_offset, written) &&
+             std::fwrite(descs.data(), sizeof(ColumnDesc), descs.size(), f) ==
+                 descs.size();
+    } else if (ok) {
+        ok = pad_to(f, desc_offset, written);
+    }
+    const int saved_errno = errno;
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok && errno == 0) errno = saved_errno;
+    return ok;
+}
+
+} // namespace alikhan
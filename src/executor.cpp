@@ -0,0 +1,188 @@
+#include "alikhan/executor.hpp"
+
+#include "alikhan/numa.hpp"
+
+namespace alikhan {
+
+namespace {
+
+// Which executor (if any) owns the current thread, and the worker's
+// index in it; used to route submit() to the caller's own queue.
+thread_local Executor* tls_executor = nullptr;
+thread_local unsigned tls_worker_index = 0;
+
+constexpr std::size_t kQueueCapacity = 4096;
+
+} // namespace
+
+Executor::Executor(unsigned threads) : Executor(Options{threads, false}) {}
+
+Executor::Executor(const Options& opts) : opts_(opts) {
+    unsigned threads = opts_.threads;
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+    opts_.threads = threads;
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        queues_.push_back(std::make_unique<WorkerState>(kQueueCapacity));
+    build_steal_orders();
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        workers_.emplace_back([this, i] { worker_loop(i); });
+}
+
+void Executor::build_steal_orders() {
+    const unsigned n = unsigned(queues_.size());
+    const unsigned nodes = numa::node_count();
+    // Workers are assigned to nodes round-robin; with pinning off (or
+    // one node) every worker is node 0 and this degenerates to the
+    // plain rotation.
+    std::vector<unsigned> node_of(n, 0);
+    if (opts_.pin_to_nodes && nodes > 1)
+        for (unsigned i = 0; i < n; ++i) node_of[i] = i % nodes;
+
+    steal_order_.assign(n, {});
+    for (unsigned w = 0; w < n; ++w) {
+        auto& order = steal_order_[w];
+        order.reserve(n);
+        order.push_back(w);
+        for (unsigned i = 1; i < n; ++i) {
+            const unsigned v = (w + i) % n;
+            if (node_of[v] == node_of[w]) order.push_back(v);
+        }
+        for (unsigned i = 1; i < n; ++i) {
+            const unsigned v = (w + i) % n;
+            if (node_of[v] != node_of[w]) order.push_back(v);
+        }
+    }
+}
+
+Executor::~Executor() {
+    // Let queued work finish, then stop the workers.
+    while (pending_.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+    stopping_.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(park_mu_);
+    }
+    park_cv_.notify_all();
+    for (auto& w : workers_) w.join();
+}
+
+void Executor::submit(Task task) {
+    pending_.fetch_add(1, std::memory_order_release);
+    push_task(std::move(task));
+    wake_one();
+}
+
+void Executor::push_task(Task&& task) {
+    // Prefer the submitting worker's own queue; fall back to scanning
+    // the others, and run inline as a last resort so a full ring can
+    // never deadlock a worker submitting to itself.
+    const unsigned n = unsigned(queues_.size());
+    unsigned start = tls_executor == this
+                         ? tls_worker_index
+                         : next_queue_.fetch_add(1, std::memory_order_relaxed) % n;
+    for (unsigned i = 0; i < n; ++i) {
+        if (queues_[(start + i) % n]->queue.try_push(std::move(task)))
+            return;
+        // try_push only moves from `task` on success; it is intact here.
+    }
+    task();
+    pending_.fetch_sub(1, std::memory_order_release);
+}
+
+void Executor::wake_one() {
+    park_cv_.notify_one();
+}
+
+bool Executor::try_run_one(unsigned self) {
+    Task task;
+    for (const unsigned victim : steal_order_[self]) {
+        if (queues_[victim]->queue.try_pop(task)) {
+            task();
+            pending_.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Executor::worker_loop(unsigned index) {
+    tls_executor = this;
+    tls_worker_index = index;
+    if (opts_.pin_to_nodes && numa::available())
+        numa::pin_thread_to_node(index % numa::node_count());
+    for (;;) {
+        if (try_run_one(index)) continue;
+        // Spin briefly before parking; steals usually land within a
+        // few tries when the pool is busy.
+        bool found = false;
+        for (int spin = 0; spin < 64 && !found; ++spin) {
+            std::this_thread::yield();
+            found = try_run_one(index);
+        }
+        if (found) continue;
+        std::unique_lock<std::mutex> lock(park_mu_);
+        park_cv_.wait(lock, [this] {
+            return pending_.load(std::memory_order_acquire) != 0 ||
+                   stopping_.load(std::memory_order_acquire);
+        });
+        if (stopping_.load(std::memory_order_acquire) &&
+            pending_.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+void Executor::parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+    const std::size_t total = (end - begin + grain - 1) / grain;
+    if (total == 1 || worker_count() == 1) {
+        fn(begin, end);
+        return;
+    }
+
+    struct Shared {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+    };
+    // Shared state outlives this frame via shared_ptr: a helper task
+    // may only be dequeued after every chunk is claimed, and it must
+    // still be able to read `next` safely before bowing out. `fn` is
+    // captured by reference, which is safe because a helper touches it
+    // only after claiming a chunk -- and we do not return until every
+    // claimed chunk is done.
+    auto shared = std::make_shared<Shared>();
+
+    auto pull_chunks = [shared, &fn, begin, end, grain, total] {
+        for (;;) {
+            const std::size_t c = shared->next.fetch_add(1, std::memory_order_relaxed);
+            if (c >= total) return;
+            const std::size_t lo = begin + c * grain;
+            const std::size_t hi = lo + grain < end ? lo + grain : end;
+            fn(lo, hi);
+            shared->done.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    const unsigned helpers =
+        unsigned(total - 1 < worker_count() ? total - 1 : worker_count());
+    for (unsigned i = 0; i < helpers; ++i)
+        submit(pull_chunks);
+    pull_chunks();
+
+    // All chunks are claimed once we get here; wait for stragglers.
+    while (shared->done.load(std::memory_order_acquire) != total)
+        std::this_thread::yield();
+}
+
+Executor& Executor::global() {
+    static Executor exec;
+    return exec;
+}
+
+} // namespace alikhan
@@ -0,0 +1,214 @@
+#include "alikhan/hash.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace alikhan {
+
+namespace {
+
+// 64 bytes of secret, one u64 per lane.
+constexpr std::uint64_t kSecret[8] = {
+    0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull,
+    0x1f67b3b7a4a44072ull, 0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull,
+    0x8e2443f7744608b8ull, 0x4f0bd7323cfe7f39ull,
+};
+
+constexpr std::uint64_t kPrimeMix = 0x2545F4914F6CDD1Dull;
+constexpr std::uint64_t kPrimeLen = 0x9E3779B97F4A7C15ull;
+
+inline std::uint64_t load64(const unsigned char* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void accumulate_scalar(std::uint64_t acc[8], const unsigned char* data,
+                       std::size_t nblocks) noexcept {
+    for (std::size_t b = 0; b < nblocks; ++b, data += 64) {
+        for (int i = 0; i < 8; ++i) {
+            const std::uint64_t dv = load64(data + 8 * i);
+            const std::uint64_t dk = dv ^ kSecret[i];
+            acc[i] += (dk & 0xFFFFFFFFull) * (dk >> 32) + dv;
+        }
+    }
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+void accumulate_avx2(std::uint64_t acc[8], const unsigned char* data,
+                     std::size_t nblocks) noexcept {
+    __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+    __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+    const __m256i k0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kSecret));
+    const __m256i k1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kSecret + 4));
+    for (std::size_t b = 0; b < nblocks; ++b, data += 64) {
+        const __m256i d0 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        const __m256i d1 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+        const __m256i x0 = _mm256_xor_si256(d0, k0);
+        const __m256i x1 = _mm256_xor_si256(d1, k1);
+        // (low32 * high32) + data, per 64-bit lane -- identical to the
+        // scalar kernel.
+        a0 = _mm256_add_epi64(
+            a0, _mm256_add_epi64(
+                    _mm256_mul_epu32(x0, _mm256_srli_epi64(x0, 32)), d0));
+        a1 = _mm256_add_epi64(
+            a1, _mm256_add_epi64(
+                    _mm256_mul_epu32(x1, _mm256_srli_epi64(x1, 32)), d1));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), a0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), a1);
+}
+
+#endif // __x86_64__
+
+using AccumulateFn = void (*)(std::uint64_t[8], const unsigned char*,
+                              std::size_t) noexcept;
+
+AccumulateFn resolve_accumulate() noexcept {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) return accumulate_avx2;
+#endif
+    return accumulate_scalar;
+}
+
+void accumulate(std::uint64_t acc[8], const unsigned char* data,
+                std::size_t nblocks) noexcept {
+    static const AccumulateFn fn = resolve_accumulate();
+    fn(acc, data, nblocks);
+}
+
+void init_acc(std::uint64_t acc[8], std::uint64_t seed) noexcept {
+    for (int i = 0; i < 8; ++i) acc[i] = kSecret[i] ^ seed;
+}
+
+// Zero-pads the trailing partial block (also handles len == 0) and
+// folds it scalar so every ISA and the streaming form agree.
+void accumulate_tail(std::uint64_t acc[8], const unsigned char* tail,
+                     std::size_t len) noexcept {
+    unsigned char block[64] = {};
+    std::memcpy(block, tail, len);
+    accumulate_scalar(acc, block, 1);
+}
+
+std::uint64_t fold64(const std::uint64_t acc[8], std::uint64_t len,
+                     std::uint64_t seed) noexcept {
+    std::uint64_t h = seed ^ (len * kPrimeLen);
+    for (int i = 0; i < 8; ++i) {
+        h += acc[i];
+        h = (h ^ (h >> 27)) * kPrimeMix;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 29;
+    return h;
+}
+
+std::uint64_t fold_hi(const std::uint64_t acc[8], std::uint64_t len,
+                      std::uint64_t seed) noexcept {
+    std::uint64_t h = ~seed + (len * kPrimeMix);
+    for (int i = 7; i >= 0; --i) {
+        h ^= acc[i];
+        h = (h + (h >> 31)) * kPrimeLen;
+    }
+    h ^= h >> 30;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+} // namespace
+
+std::uint64_t fast_hash(std::string_view data, std::uint64_t seed) noexcept {
+    std::uint64_t acc[8];
+    init_acc(acc, seed);
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    const std::size_t full = data.size() / 64;
+    accumulate(acc, p, full);
+    accumulate_tail(acc, p + full * 64, data.size() % 64);
+    return fold64(acc, data.size(), seed);
+}
+
+Hash128 fast_hash128(std::string_view data, std::uint64_t seed) noexcept {
+    std::uint64_t acc[8];
+    init_acc(acc, seed);
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    const std::size_t full = data.size() / 64;
+    accumulate(acc, p, full);
+    accumulate_tail(acc, p + full * 64, data.size() % 64);
+    return {fold64(acc, data.size(), seed), fold_hi(acc, data.size(), seed)};
+}
+
+void StreamingHash::reset(std::uint64_t seed) noexcept {
+    init_acc(acc_, seed);
+    seed_ = seed;
+    total_ = 0;
+    buffered_ = 0;
+}
+
+void StreamingHash::update(std::string_view data) noexcept {
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    std::size_t n = data.size();
+    total_ += n;
+
+    if (buffered_ != 0) {
+        const std::size_t take =
+            n < std::size_t(64 - buffered_) ? n : std::size_t(64 - buffered_);
+        std::memcpy(buf_ + buffered_, p, take);
+        buffered_ += unsigned(take);
+        p += take;
+        n -= take;
+        // Only flush a full buffer when more input follows: the final
+        // block must stay buffered for the tail fold.
+        if (buffered_ == 64 && n != 0) {
+            accumulate(acc_, buf_, 1);
+            buffered_ = 0;
+        }
+    }
+
+    if (n > 64) {
+        // Keep at least one byte for the tail.
+        const std::size_t full = (n - 1) / 64;
+        accumulate(acc_, p, full);
+        p += full * 64;
+        n -= full * 64;
+    }
+    if (n != 0) {
+        std::memcpy(buf_, p, n);
+        buffered_ = unsigned(n);
+    }
+}
+
+std::uint64_t StreamingHash::digest64() const noexcept {
+    std::uint64_t acc[8];
+    std::memcpy(acc, acc_, sizeof(acc));
+    if (buffered_ == 64) {
+        accumulate_scalar(acc, buf_, 1);
+        accumulate_tail(acc, buf_, 0);
+    } else {
+        accumulate_tail(acc, buf_, buffered_);
+    }
+    return fold64(acc, total_, seed_);
+}
+
+Hash128 StreamingHash::digest128() const noexcept {
+    std::uint64_t acc[8];
+    std::memcpy(acc, acc_, sizeof(acc));
+    if (buffered_ == 64) {
+        accumulate_scalar(acc, buf_, 1);
+        accumulate_tail(acc, buf_, 0);
+    } else {
+        accumulate_tail(acc, buf_, buffered_);
+    }
+    return {fold64(acc, total_, seed_), fold_hi(acc, total_, seed_)};
+}
+
+} // namespace alikhan
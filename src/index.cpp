@@ -0,0 +1,437 @@
+#include "alikhan/index.hpp"
+
+#include <cerrno>
+#include <cstdio>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace alikhan {
+
+namespace svb {
+
+namespace {
+
+constexpr std::uint8_t byte_length(std::uint32_t v) noexcept {
+    if (v < (1u << 8)) return 1;
+    if (v < (1u << 16)) return 2;
+    if (v < (1u << 24)) return 3;
+    return 4;
+}
+
+#if defined(__x86_64__)
+
+// Per-control-byte decode tables: total data length consumed and the
+// pshufb mask that expands the packed bytes into four u32 lanes.
+struct Tables {
+    std::uint8_t len[256];
+    std::uint8_t shuf[256][16];
+};
+
+constexpr Tables make_tables() {
+    Tables t{};
+    for (int c = 0; c < 256; ++c) {
+        std::uint8_t offset = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            const int l = ((c >> (2 * lane)) & 3) + 1;
+            for (int b = 0; b < 4; ++b)
+                t.shuf[c][lane * 4 + b] =
+                    b < l ? offset + std::uint8_t(b) : std::uint8_t(0x80);
+            offset += std::uint8_t(l);
+        }
+        t.len[c] = offset;
+    }
+    return t;
+}
+
+constexpr Tables kTables = make_tables();
+
+__attribute__((target("ssse3")))
+std::size_t decode_ssse3(const std::uint8_t* in, std::size_t in_size,
+                         std::size_t n, std::uint32_t* out) {
+    const std::uint8_t* control = in;
+    const std::uint8_t* data = in + (n + 3) / 4;
+    const std::uint8_t* load_limit = in + in_size;
+    std::size_t i = 0;
+    // Full groups of four while a 16-byte load stays inside the
+    // encoded region; the scalar tail finishes the rest, so a list at
+    // the end of a mapping never touches bytes past it.
+    while (i + 4 <= n && data + 16 <= load_limit) {
+        const std::uint8_t c = control[i / 4];
+        const __m128i raw =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i mask = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(kTables.shuf[c]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_shuffle_epi8(raw, mask));
+        data += kTables.len[c];
+        i += 4;
+    }
+    // Scalar tail.
+    for (; i < n; ++i) {
+        const int l = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        std::uint32_t v = 0;
+        for (int b = 0; b < l; ++b)
+            v |= std::uint32_t(*data++) << (8 * b);
+        out[i] = v;
+    }
+    return std::size_t(data - in);
+}
+
+#endif // __x86_64__
+
+std::size_t decode_scalar(const std::uint8_t* in, std::size_t /*in_size*/,
+                          std::size_t n, std::uint32_t* out) {
+    const std::uint8_t* control = in;
+    const std::uint8_t* data = in + (n + 3) / 4;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int l = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        std::uint32_t v = 0;
+        for (int b = 0; b < l; ++b)
+            v |= std::uint32_t(*data++) << (8 * b);
+        out[i] = v;
+    }
+    return std::size_t(data - in);
+}
+
+using DecodeFn = std::size_t (*)(const std::uint8_t*, std::size_t, std::size_t,
+                                 std::uint32_t*);
+
+DecodeFn resolve_decode() noexcept {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("ssse3")) return decode_ssse3;
+#endif
+    return decode_scalar;
+}
+
+} // namespace
+
+std::size_t encode(const std::uint32_t* values, std::size_t n,
+                   std::uint8_t* out) {
+    std::uint8_t* control = out;
+    std::uint8_t* data = out + (n + 3) / 4;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 4 == 0) control[i / 4] = 0;
+        const std::uint32_t v = values[i];
+        const std::uint8_t l = byte_length(v);
+        control[i / 4] |= std::uint8_t(l - 1) << (2 * (i % 4));
+        for (int b = 0; b < l; ++b)
+            *data++ = std::uint8_t(v >> (8 * b));
+    }
+    return std::size_t(data - out);
+}
+
+std::size_t decode(const std::uint8_t* in, std::size_t in_size, std::size_t n,
+                   std::uint32_t* out) {
+    static const DecodeFn fn = resolve_decode();
+    return fn(in, in_size, n, out);
+}
+
+#if defined(__x86_64__)
+
+namespace {
+
+// Group loop shared with decode_ssse3, but resumable: consumes full
+// groups in [i, end) while a 16-byte load stays in bounds, advancing
+// the caller's cursor state.
+__attribute__((target("ssse3")))
+void decode_groups_ssse3(const std::uint8_t* control,
+                         const std::uint8_t*& data,
+                         const std::uint8_t* limit, std::size_t& i,
+                         std::size_t end, std::uint32_t* out) {
+    while (i + 4 <= end && data + 16 <= limit) {
+        const std::uint8_t c = control[i / 4];
+        const __m128i raw =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i mask = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(kTables.shuf[c]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm_shuffle_epi8(raw, mask));
+        data += kTables.len[c];
+        out += 4;
+        i += 4;
+    }
+}
+
+} // namespace
+
+#endif // __x86_64__
+
+std::size_t Decoder::decode_next(std::size_t m, std::uint32_t* out) noexcept {
+    if (m > n_ - i_) m = n_ - i_;
+    const std::size_t end = i_ + m;
+#if defined(__x86_64__)
+    static const bool have_ssse3 = __builtin_cpu_supports("ssse3");
+    if (have_ssse3 && i_ % 4 == 0) {
+        const std::size_t before = i_;
+        decode_groups_ssse3(control_, data_, limit_, i_, end, out);
+        out += i_ - before;
+    }
+#endif
+    while (i_ < end) {
+        const int l = ((control_[i_ / 4] >> (2 * (i_ % 4))) & 3) + 1;
+        std::uint32_t v = 0;
+        for (int b = 0; b < l; ++b)
+            v |= std::uint32_t(*data_++) << (8 * b);
+        *out++ = v;
+        ++i_;
+    }
+    return m;
+}
+
+} // namespace svb
+
+namespace {
+
+// Delta-encodes an ascending doc id list into an svb blob.
+std::string encode_posting_blob(std::vector<std::uint32_t>& deltas) {
+    for (std::size_t i = deltas.size(); i-- > 1;)
+        deltas[i] -= deltas[i - 1];
+    std::string blob(svb::max_encoded_size(deltas.size()), '\0');
+    blob.resize(svb::encode(deltas.data(), deltas.size(),
+                            reinterpret_cast<std::uint8_t*>(blob.data())));
+    return blob;
+}
+
+bool write_snapshot(const std::vector<std::string_view>& terms,
+                    const std::vector<std::string>& blobs,
+                    const std::vector<std::uint32_t>& counts,
+                    const char* path, bool huge_pages) {
+    std::vector<std::string_view> blob_views(blobs.begin(), blobs.end());
+    ColumnFileWriter w;
+    if (huge_pages)
+        w.set_section_align(colfile_detail::kHugeSectionAlign);
+    w.add_bytes("terms", terms.data(), terms.size());
+    w.add_bytes("postings", blob_views.data(), blob_views.size());
+    w.add_u32("doc_counts", counts.data(), counts.size());
+    return w.write(path);
+}
+
+void add_posting(std::map<std::string, std::vector<std::uint32_t>,
+                          std::less<>>& postings,
+                 std::string_view token, std::uint32_t doc) {
+    auto it = postings.find(token);
+    if (it == postings.end())
+        it = postings.emplace(std::string(token),
+                              std::vector<std::uint32_t>())
+                 .first;
+    if (it->second.empty() || it->second.back() != doc)
+        it->second.push_back(doc);
+}
+
+} // namespace
+
+void InvertedIndexBuilder::add_document(std::uint32_t doc,
+                                        const std::string_view* tokens,
+                                        std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        add_posting(postings_, tokens[i], doc);
+}
+
+bool InvertedIndexBuilder::write(const char* path, bool huge_pages) const {
+    std::vector<std::string_view> terms;
+    std::vector<std::uint32_t> counts;
+    std::vector<std::string> blobs;
+    terms.reserve(postings_.size());
+    counts.reserve(postings_.size());
+    blobs.reserve(postings_.size());
+
+    std::vector<std::uint32_t> deltas;
+    for (const auto& [term, docs] : postings_) {
+        terms.push_back(term);
+        counts.push_back(std::uint32_t(docs.size()));
+        // First id absolute, the rest deltas; ids are ascending by
+        // the add_document contract.
+        deltas.assign(docs.begin(), docs.end());
+        blobs.push_back(encode_posting_blob(deltas));
+    }
+
+    return write_snapshot(terms, blobs, counts, path, huge_pages);
+}
+
+bool InvertedIndex::open(const char* path) noexcept {
+    if (!file_.open(path)) return false;
+    terms_ = file_.column("terms");
+    blobs_ = file_.column("postings");
+    counts_ = file_.column("doc_counts");
+    if (!terms_.valid() || !blobs_.valid() || !counts_.valid()) {
+        file_.close();
+        errno = EINVAL;
+        return false;
+    }
+    return true;
+}
+
+bool InvertedIndex::open_bytes(const char* data, std::size_t size) noexcept {
+    if (!file_.open_bytes(data, size)) return false;
+    terms_ = file_.column("terms");
+    blobs_ = file_.column("postings");
+    counts_ = file_.column("doc_counts");
+    if (!terms_.valid() || !blobs_.valid() || !counts_.valid()) {
+        file_.close();
+        errno = EINVAL;
+        return false;
+    }
+    return true;
+}
+
+std::uint32_t InvertedIndex::find_term(std::string_view t) const noexcept {
+    std::uint32_t lo = 0;
+    std::uint32_t hi = term_count();
+    while (lo < hi) {
+        const std::uint32_t mid = lo + (hi - lo) / 2;
+        const std::string_view m = terms_.get_bytes(mid);
+        if (m < t)
+            lo = mid + 1;
+        else if (t < m)
+            hi = mid;
+        else
+            return mid;
+    }
+    return kNoTerm;
+}
+
+std::size_t InvertedIndex::decode_postings(const Postings& p,
+                                           std::uint32_t* out) const {
+    svb::decode(p.encoded, p.encoded_size, p.doc_count, out);
+    for (std::size_t i = 1; i < p.doc_count; ++i)
+        out[i] += out[i - 1];
+    return p.doc_count;
+}
+
+bool IncrementalIndex::open() {
+    errno = 0;
+    if (gens_[0].open(path_.c_str())) {
+        live_.store(0, std::memory_order_release);
+        return true;
+    }
+    return errno == ENOENT;   // no snapshot yet: start empty
+}
+
+void IncrementalIndex::add_document(std::uint32_t doc,
+                                    const std::string_view* tokens,
+                                    std::size_t count) {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (std::size_t i = 0; i < count; ++i)
+        add_posting(delta_, tokens[i], doc);
+    pending_ += count;
+}
+
+std::uint64_t IncrementalIndex::pending_postings() const noexcept {
+    std::lock_guard<std::mutex> lock(mu_);
+    return pending_;
+}
+
+std::uint32_t IncrementalIndex::doc_count(std::string_view term) const {
+    std::uint32_t n = 0;
+    if (const InvertedIndex* s = snapshot()) {
+        const std::uint32_t idx = s->find_term(term);
+        if (idx != InvertedIndex::kNoTerm) n += s->doc_count(idx);
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    if (auto it = merging_.find(term); it != merging_.end())
+        n += std::uint32_t(it->second.size());
+    if (auto it = delta_.find(term); it != delta_.end())
+        n += std::uint32_t(it->second.size());
+    return n;
+}
+
+std::size_t IncrementalIndex::lookup(std::string_view term,
+                                     std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (const InvertedIndex* s = snapshot()) {
+        const std::uint32_t idx = s->find_term(term);
+        if (idx != InvertedIndex::kNoTerm) {
+            const InvertedIndex::Postings p = s->postings(idx);
+            out.resize(p.doc_count);
+            s->decode_postings(p, out.data());
+        }
+    }
+    // Snapshot ids precede merging ids precede delta ids (doc ids
+    // ascend across generations), so union is concatenation.
+    std::lock_guard<std::mutex> lock(mu_);
+    if (auto it = merging_.find(term); it != merging_.end())
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    if (auto it = delta_.find(term); it != delta_.end())
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    return out.size();
+}
+
+bool IncrementalIndex::compact() {
+    {
+        // Freeze the delta; new writes land in a fresh one and stay
+        // queryable via the delta path during the merge.
+        std::lock_guard<std::mutex> lock(mu_);
+        if (delta_.empty()) return true;
+        merging_ = std::move(delta_);
+        delta_ = PostingMap();
+        pending_ = 0;
+    }
+
+    // Stream-merge sorted snapshot terms with the frozen delta.
+    const InvertedIndex* snap = snapshot();
+    std::vector<std::string_view> terms;
+    std::vector<std::string> blobs;
+    std::vector<std::uint32_t> counts;
+    std::vector<std::uint32_t> docs;
+
+    const std::uint32_t snap_terms = snap != nullptr ? snap->term_count() : 0;
+    std::uint32_t si = 0;
+    auto mi = merging_.begin();
+    while (si < snap_terms || mi != merging_.end()) {
+        const std::string_view st =
+            si < snap_terms ? snap->term(si) : std::string_view();
+        const bool take_snap =
+            mi == merging_.end() ||
+            (si < snap_terms && st <= std::string_view(mi->first));
+        const bool take_delta =
+            si >= snap_terms ||
+            (mi != merging_.end() && std::string_view(mi->first) <= st);
+
+        docs.clear();
+        if (take_snap) {
+            const InvertedIndex::Postings p = snap->postings(si);
+            docs.resize(p.doc_count);
+            snap->decode_postings(p, docs.data());
+            terms.push_back(st);
+            ++si;
+        }
+        if (take_delta) {
+            docs.insert(docs.end(), mi->second.begin(), mi->second.end());
+            if (!take_snap) terms.push_back(mi->first);
+            ++mi;
+        }
+        counts.push_back(std::uint32_t(docs.size()));
+        blobs.push_back(encode_posting_blob(docs));
+    }
+
+    const std::string tmp = path_ + ".tmp";
+    if (!write_snapshot(terms, blobs, counts, tmp.c_str(), huge_pages_) ||
+        std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        // Keep the data queryable and retryable: fold the frozen
+        // delta back in front of any newer writes.
+        std::lock_guard<std::mutex> lock(mu_);
+        for (auto& [term, ids] : delta_) {
+            auto& dst = merging_[term];
+            dst.insert(dst.end(), ids.begin(), ids.end());
+        }
+        delta_ = std::move(merging_);
+        merging_ = PostingMap();
+        for (const auto& [term, ids] : delta_) pending_ += ids.size();
+        return false;
+    }
+
+    // Swap readers to the new generation; the old mapping stays open
+    // for queries already using it.
+    const unsigned next = live_.load(std::memory_order_relaxed) ^ 1u;
+    gens_[next].close();
+    if (!gens_[next].open(path_.c_str())) return false;
+    live_.store(next, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(mu_);
+    merging_ = PostingMap();
+    return true;
+}
+
+} // namespace alikhan
@@ -0,0 +1,101 @@
+#include "alikhan/intern.hpp"
+
+#include "alikhan/hash.hpp"
+
+#include <cstring>
+
+namespace alikhan {
+
+namespace {
+
+std::uint64_t hash_bytes(std::string_view s) noexcept {
+    return fast_hash(s);
+}
+
+std::size_t next_pow2(std::size_t v) noexcept {
+    std::size_t p = 1;
+    while (p < v) p *= 2;
+    return p;
+}
+
+} // namespace
+
+InternPool::InternPool(Arena& arena, std::size_t initial_capacity)
+    : arena_(arena) {
+    const std::size_t cap = next_pow2(initial_capacity < 8 ? 8 : initial_capacity);
+    slot_mask_ = cap - 1;
+    slots_ = static_cast<Symbol*>(
+        arena_.allocate(cap * sizeof(Symbol), alignof(Symbol)));
+    std::memset(slots_, 0xFF, cap * sizeof(Symbol));
+    entry_cap_ = cap / 2;
+    entries_ = static_cast<Entry*>(
+        arena_.allocate(entry_cap_ * sizeof(Entry), alignof(Entry)));
+}
+
+InternPool::Symbol InternPool::intern(std::string_view s) {
+    const std::uint64_t h = hash_bytes(s);
+    const std::uint32_t h32 = std::uint32_t(h);
+    std::size_t i = std::size_t(h) & slot_mask_;
+    for (;;) {
+        const Symbol sym = slots_[i];
+        if (sym == kInvalid) break;
+        const Entry& e = entries_[sym];
+        if (e.hash == h32 && e.len == s.size() &&
+            std::memcmp(e.data, s.data(), s.size()) == 0)
+            return sym;
+        i = (i + 1) & slot_mask_;
+    }
+
+    // Insert. Grow first if this would push load past ~0.7.
+    if ((count_ + 1) * 10 > (slot_mask_ + 1) * 7) {
+        grow();
+        i = std::size_t(h) & slot_mask_;
+        while (slots_[i] != kInvalid) i = (i + 1) & slot_mask_;
+    }
+
+    if (count_ == entry_cap_) {
+        Entry* bigger = static_cast<Entry*>(
+            arena_.allocate(entry_cap_ * 2 * sizeof(Entry), alignof(Entry)));
+        std::memcpy(bigger, entries_, count_ * sizeof(Entry));
+        entries_ = bigger;
+        entry_cap_ *= 2;
+    }
+
+    const Symbol sym = Symbol(count_++);
+    entries_[sym] = {arena_.dup(s.data(), s.size()), std::uint32_t(s.size()), h32};
+    slots_[i] = sym;
+    return sym;
+}
+
+InternPool::Symbol InternPool::find(std::string_view s) const noexcept {
+    const std::uint64_t h = hash_bytes(s);
+    const std::uint32_t h32 = std::uint32_t(h);
+    std::size_t i = std::size_t(h) & slot_mask_;
+    for (;;) {
+        const Symbol sym = slots_[i];
+        if (sym == kInvalid) return kInvalid;
+        const Entry& e = entries_[sym];
+        if (e.hash == h32 && e.len == s.size() &&
+            std::memcmp(e.data, s.data(), s.size()) == 0)
+            return sym;
+        i = (i + 1) & slot_mask_;
+    }
+}
+
+void InternPool::grow() {
+    const std::size_t new_cap = (slot_mask_ + 1) * 2;
+    Symbol* fresh = static_cast<Symbol*>(
+        arena_.allocate(new_cap * sizeof(Symbol), alignof(Symbol)));
+    std::memset(fresh, 0xFF, new_cap * sizeof(Symbol));
+    const std::size_t new_mask = new_cap - 1;
+    for (std::size_t sym = 0; sym < count_; ++sym) {
+        const Entry& e = entries_[sym];
+        std::size_t i = std::size_t(hash_bytes({e.data, e.len})) & new_mask;
+        while (fresh[i] != kInvalid) i = (i + 1) & new_mask;
+        fresh[i] = Symbol(sym);
+    }
+    slots_ = fresh;
+    slot_mask_ = new_mask;
+}
+
+} // namespace alikhan
@@ -0,0 +1,363 @@
+#include "alikhan/io_engine.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+std::uint64_t now_ns() noexcept {
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count());
+}
+
+} // namespace
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ALIKHAN_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#else
+#define ALIKHAN_HAS_IO_URING 0
+#endif
+
+namespace alikhan {
+
+#if ALIKHAN_HAS_IO_URING
+
+namespace {
+
+int sys_io_uring_setup(unsigned entries, io_uring_params* p) {
+    return int(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                       unsigned flags) {
+    return int(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                         flags, nullptr, 0));
+}
+
+template <typename T>
+T* ring_ptr(void* base, std::uint32_t off) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + off);
+}
+
+} // namespace
+
+// Minimal single-issuer io_uring wrapper: one SQ/CQ pair mapped at
+// construction, torn down in the destructor. No liburing -- the ring
+// is driven through the two syscalls and the shared-memory indices.
+struct IoEngine::Ring {
+    int fd = -1;
+    void* sq_mem = nullptr;
+    std::size_t sq_len = 0;
+    void* cq_mem = nullptr;
+    std::size_t cq_len = 0;
+    io_uring_sqe* sqes = nullptr;
+    std::size_t sqes_len = 0;
+
+    std::atomic<std::uint32_t>* sq_head = nullptr;
+    std::atomic<std::uint32_t>* sq_tail = nullptr;
+    std::uint32_t sq_mask = 0;
+    std::uint32_t* sq_array = nullptr;
+
+    std::atomic<std::uint32_t>* cq_head = nullptr;
+    std::atomic<std::uint32_t>* cq_tail = nullptr;
+    std::uint32_t cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    bool init(unsigned entries) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        fd = sys_io_uring_setup(entries, &p);
+        if (fd < 0) return false;
+
+        sq_len = p.sq_off.array + p.sq_entries * sizeof(std::uint32_t);
+        cq_len = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        sq_mem = ::mmap(nullptr, sq_len, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cq_mem = ::mmap(nullptr, cq_len, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        sqes_len = p.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(
+            ::mmap(nullptr, sqes_len, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sq_mem == MAP_FAILED || cq_mem == MAP_FAILED ||
+            sqes == MAP_FAILED) {
+            destroy();
+            return false;
+        }
+
+        sq_head = ring_ptr<std::atomic<std::uint32_t>>(sq_mem, p.sq_off.head);
+        sq_tail = ring_ptr<std::atomic<std::uint32_t>>(sq_mem, p.sq_off.tail);
+        sq_mask = *ring_ptr<std::uint32_t>(sq_mem, p.sq_off.ring_mask);
+        sq_array = ring_ptr<std::uint32_t>(sq_mem, p.sq_off.array);
+
+        cq_head = ring_ptr<std::atomic<std::uint32_t>>(cq_mem, p.cq_off.head);
+        cq_tail = ring_ptr<std::atomic<std::uint32_t>>(cq_mem, p.cq_off.tail);
+        cq_mask = *ring_ptr<std::uint32_t>(cq_mem, p.cq_off.ring_mask);
+        cqes = ring_ptr<io_uring_cqe>(cq_mem, p.cq_off.cqes);
+        return true;
+    }
+
+    void destroy() {
+        if (sqes != nullptr && sqes != MAP_FAILED) ::munmap(sqes, sqes_len);
+        if (sq_mem != nullptr && sq_mem != MAP_FAILED) ::munmap(sq_mem, sq_len);
+        if (cq_mem != nullptr && cq_mem != MAP_FAILED) ::munmap(cq_mem, cq_len);
+        if (fd >= 0) ::close(fd);
+        sqes = nullptr;
+        sq_mem = cq_mem = nullptr;
+        fd = -1;
+    }
+
+    ~Ring() { destroy(); }
+
+    // Queues one READ sqe; caller submits via enter().
+    void push_read(int file_fd, void* buf, std::uint32_t len,
+                   std::uint64_t user_data) {
+        const std::uint32_t tail = sq_tail->load(std::memory_order_relaxed);
+        const std::uint32_t idx = tail & sq_mask;
+        io_uring_sqe* sqe = &sqes[idx];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = file_fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(buf);
+        sqe->len = len;
+        sqe->off = 0;
+        sqe->user_data = user_data;
+        sq_array[idx] = idx;
+        sq_tail->store(tail + 1, std::memory_order_release);
+    }
+
+    // Returns false when the CQ is empty.
+    bool pop(io_uring_cqe& out) {
+        const std::uint32_t head = cq_head->load(std::memory_order_acquire);
+        if (head == cq_tail->load(std::memory_order_acquire)) return false;
+        out = cqes[head & cq_mask];
+        cq_head->store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#else
+
+struct IoEngine::Ring {};
+
+#endif // ALIKHAN_HAS_IO_URING
+
+IoEngine::IoEngine() : IoEngine(Options()) {}
+
+IoEngine::IoEngine(Options opts) : opts_(opts) {
+    if (opts_.queue_depth == 0) opts_.queue_depth = 1;
+#if ALIKHAN_HAS_IO_URING
+    auto ring = std::make_unique<Ring>();
+    // Probe at construction: sandboxes and old kernels reject
+    // io_uring_setup, in which case the pread fallback serves.
+    if (ring->init(opts_.queue_depth)) ring_ = std::move(ring);
+#endif
+}
+
+IoEngine::~IoEngine() = default;
+
+bool IoEngine::using_uring() const noexcept { return ring_ != nullptr; }
+
+void IoEngine::submit_read(std::string path, ReadCallback cb) {
+    Request req;
+    req.path = std::move(path);
+    req.cb = std::move(cb);
+    queue_.push_back(std::move(req));
+}
+
+bool IoEngine::prepare(Request& req) {
+    req.fd = ::open(req.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (req.fd < 0) return false;
+    struct stat st;
+    if (::fstat(req.fd, &st) != 0) {
+        ::close(req.fd);
+        req.fd = -1;
+        return false;
+    }
+    if (std::size_t(st.st_size) > opts_.max_file_size) {
+        ::close(req.fd);
+        req.fd = -1;
+        errno = E2BIG;
+        return false;
+    }
+    req.size = std::size_t(st.st_size);
+    req.dev = std::uint64_t(st.st_dev);
+    req.buf = std::make_unique<char[]>(req.size != 0 ? req.size : 1);
+    if (opts_.adaptive) {
+        // Ask the kernel to start pulling the learned readahead
+        // distance now; by the time the sqe lands the head of the file
+        // is already in the page cache. Advisory, so failure is fine.
+        const std::size_t dist = device(req.dev).ctl.readahead();
+        ::posix_fadvise(req.fd, 0,
+                        off_t(req.size < dist ? req.size : dist),
+                        POSIX_FADV_WILLNEED);
+    }
+    return true;
+}
+
+IoEngine::DeviceState& IoEngine::device(std::uint64_t dev) {
+    auto it = devices_.find(dev);
+    if (it == devices_.end())
+        it = devices_.emplace(dev, DeviceState(opts_.prefetch)).first;
+    return it->second;
+}
+
+const PrefetchController* IoEngine::controller(
+    const std::string& path) const noexcept {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return nullptr;
+    const auto it = devices_.find(std::uint64_t(st.st_dev));
+    return it != devices_.end() ? &it->second.ctl : nullptr;
+}
+
+std::size_t IoEngine::run() {
+    std::size_t ok;
+#if ALIKHAN_HAS_IO_URING
+    ok = ring_ != nullptr ? run_uring() : run_fallback();
+#else
+    ok = run_fallback();
+#endif
+    queue_.clear();
+    return ok;
+}
+
+std::size_t IoEngine::run_fallback() {
+    std::size_t ok = 0;
+    for (Request& req : queue_) {
+        if (!prepare(req)) {
+            req.cb(req.path, {}, errno);
+            continue;
+        }
+        std::size_t got = 0;
+        bool failed = false;
+        req.submit_ns = now_ns();
+        while (got < req.size) {
+            const ssize_t n =
+                ::pread(req.fd, req.buf.get() + got, req.size - got, off_t(got));
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) continue;
+                failed = true;
+                break;
+            }
+            got += std::size_t(n);
+        }
+        ::close(req.fd);
+        req.fd = -1;
+        // Depth is pinned at 1 here, but feeding the controller keeps
+        // the readahead distance adapting on the fallback path too.
+        if (opts_.adaptive && !failed)
+            device(req.dev).ctl.record((now_ns() - req.submit_ns) / 1000);
+        if (failed) {
+            req.cb(req.path, {}, errno != 0 ? errno : EIO);
+        } else {
+            req.cb(req.path, {req.buf.get(), got}, 0);
+            ++ok;
+        }
+        req.buf.reset();
+    }
+    return ok;
+}
+
+#if ALIKHAN_HAS_IO_URING
+
+std::size_t IoEngine::run_uring() {
+    std::size_t ok = 0;
+    std::size_t next = 0;        // next request to submit
+    std::size_t inflight = 0;
+    std::size_t completed = 0;
+    unsigned to_submit = 0;
+
+    while (completed < queue_.size()) {
+        // Fill the ring up to queue_depth (or, when adaptive, the
+        // head request's per-device admission limit).
+        while (next < queue_.size() && inflight < opts_.queue_depth) {
+            Request& req = queue_[next];
+            if (req.fd < 0 && !prepare(req)) {
+                req.cb(req.path, {}, errno);
+                ++next;
+                ++completed;
+                continue;
+            }
+            if (opts_.adaptive) {
+                DeviceState& ds = device(req.dev);
+                // The queue is FIFO; a saturated head device pauses
+                // submission until one of its reads completes (the
+                // request stays prepared, fd open, for next round).
+                if (ds.inflight >= ds.ctl.depth()) break;
+                ++ds.inflight;
+            }
+            req.submit_ns = now_ns();
+            ring_->push_read(req.fd, req.buf.get(), std::uint32_t(req.size),
+                             std::uint64_t(next));
+            ++to_submit;
+            ++inflight;
+            ++next;
+        }
+
+        if (inflight == 0) continue;   // everything so far failed open
+
+        // Submit the batch and wait for at least one completion.
+        const int r = sys_io_uring_enter(ring_->fd, to_submit, 1,
+                                         IORING_ENTER_GETEVENTS);
+        if (r < 0 && errno != EINTR) {
+            // Ring wedged (should not happen): finish the rest
+            // synchronously rather than spinning.
+            for (std::size_t i = 0; i < queue_.size(); ++i) {
+                Request& req = queue_[i];
+                if (req.fd >= 0) {
+                    ::close(req.fd);
+                    req.fd = -1;
+                    req.cb(req.path, {}, EIO);
+                }
+            }
+            for (auto& [dev, ds] : devices_) ds.inflight = 0;
+            return ok;
+        }
+        to_submit = 0;
+
+        io_uring_cqe cqe;
+        while (ring_->pop(cqe)) {
+            Request& req = queue_[cqe.user_data];
+            ::close(req.fd);
+            req.fd = -1;
+            if (opts_.adaptive) {
+                DeviceState& ds = device(req.dev);
+                --ds.inflight;
+                ds.ctl.record((now_ns() - req.submit_ns) / 1000);
+            }
+            if (cqe.res < 0) {
+                req.cb(req.path, {}, -cqe.res);
+            } else if (std::size_t(cqe.res) < req.size) {
+                // Short read on a regular file: treat as truncation.
+                req.cb(req.path, {req.buf.get(), std::size_t(cqe.res)}, 0);
+                ++ok;
+            } else {
+                req.cb(req.path, {req.buf.get(), req.size}, 0);
+                ++ok;
+            }
+            req.buf.reset();
+            --inflight;
+            ++completed;
+        }
+    }
+    return ok;
+}
+
+#else
+
+std::size_t IoEngine::run_uring() { return run_fallback(); }
+
+#endif // ALIKHAN_HAS_IO_URING
+
+} // namespace alikhan
@@ -0,0 +1,68 @@
+#include "alikhan/mmap_io.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace alikhan {
+
+bool MappedFile::open(const char* path) noexcept {
+    close();
+
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size == 0) {
+        // mmap rejects zero-length maps; represent an empty file with a
+        // distinct non-null sentinel so is_open() stays truthful.
+        ::close(fd);
+        data_ = reinterpret_cast<const char*>(&size_);
+        size_ = 0;
+        return true;
+    }
+
+    void* p = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file referenced
+    if (p == MAP_FAILED) return false;
+
+    data_ = static_cast<const char*>(p);
+    size_ = std::size_t(st.st_size);
+    return true;
+}
+
+void MappedFile::close() noexcept {
+    if (data_ != nullptr && size_ != 0)
+        ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool MappedFile::advise(Advice a, std::size_t offset, std::size_t length) const noexcept {
+    if (data_ == nullptr || size_ == 0) return false;
+    if (offset > size_) return false;
+    if (length > size_ - offset) length = size_ - offset;
+
+    // madvise wants page-aligned addresses; widen the range outward.
+    const std::size_t page = std::size_t(::sysconf(_SC_PAGESIZE));
+    const std::size_t begin = offset & ~(page - 1);
+    const std::size_t end = offset + length;
+
+    int advice = MADV_NORMAL;
+    switch (a) {
+    case Advice::Normal:     advice = MADV_NORMAL; break;
+    case Advice::Sequential: advice = MADV_SEQUENTIAL; break;
+    case Advice::Random:     advice = MADV_RANDOM; break;
+    case Advice::WillNeed:   advice = MADV_WILLNEED; break;
+    case Advice::Huge:       advice = MADV_HUGEPAGE; break;
+    }
+    return ::madvise(const_cast<char*>(data_) + begin, end - begin, advice) == 0;
+}
+
+} // namespace alikhan
@@ -0,0 +1,115 @@
+#include "alikhan/numa.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sched.h>
+
+namespace alikhan {
+namespace numa {
+
+namespace {
+
+constexpr unsigned kMaxCpus = 4096;
+
+struct Topology {
+    unsigned nodes = 1;
+    std::vector<std::uint16_t> cpu_node;   // cpu -> node
+    std::vector<cpu_set_t> node_cpus;      // node -> affinity mask
+};
+
+// Parses "0-3,8-11" style cpulist files.
+void parse_cpulist(const char* text, unsigned node, Topology& t) {
+    const char* p = text;
+    while (*p != '\0' && *p != '\n') {
+        char* end = nullptr;
+        const unsigned long lo = std::strtoul(p, &end, 10);
+        unsigned long hi = lo;
+        p = end;
+        if (*p == '-') {
+            hi = std::strtoul(p + 1, &end, 10);
+            p = end;
+        }
+        for (unsigned long c = lo; c <= hi && c < kMaxCpus; ++c) {
+            if (c >= t.cpu_node.size()) t.cpu_node.resize(c + 1, 0);
+            t.cpu_node[c] = std::uint16_t(node);
+            CPU_SET(int(c), &t.node_cpus[node]);
+        }
+        if (*p == ',') ++p;
+    }
+}
+
+Topology build_topology() {
+    Topology t;
+    // Count online nodes first; nodes are numbered densely in
+    // practice, and we fall back to one node the moment a read fails.
+    unsigned nodes = 0;
+    char path[128];
+    for (;; ++nodes) {
+        std::snprintf(path, sizeof(path),
+                      "/sys/devices/system/node/node%u/cpulist", nodes);
+        std::FILE* f = std::fopen(path, "r");
+        if (f == nullptr) break;
+        std::fclose(f);
+    }
+    if (nodes == 0) nodes = 1;
+    t.nodes = nodes;
+    t.node_cpus.resize(nodes);
+    for (auto& set : t.node_cpus) CPU_ZERO(&set);
+
+    for (unsigned n = 0; n < nodes; ++n) {
+        std::snprintf(path, sizeof(path),
+                      "/sys/devices/system/node/node%u/cpulist", n);
+        std::FILE* f = std::fopen(path, "r");
+        if (f == nullptr) continue;
+        char buf[4096];
+        if (std::fgets(buf, sizeof(buf), f) != nullptr)
+            parse_cpulist(buf, n, t);
+        std::fclose(f);
+    }
+    return t;
+}
+
+const Topology& topology() noexcept {
+    static const Topology t = build_topology();
+    return t;
+}
+
+} // namespace
+
+unsigned node_count() noexcept { return topology().nodes; }
+
+bool available() noexcept { return node_count() > 1; }
+
+unsigned node_of_cpu(unsigned cpu) noexcept {
+    const Topology& t = topology();
+    return cpu < t.cpu_node.size() ? t.cpu_node[cpu] : 0;
+}
+
+unsigned current_node() noexcept {
+    const int cpu = ::sched_getcpu();
+    return cpu >= 0 ? node_of_cpu(unsigned(cpu)) : 0;
+}
+
+bool pin_thread_to_node(unsigned node) noexcept {
+    const Topology& t = topology();
+    if (node >= t.nodes) node = 0;
+    if (CPU_COUNT(&t.node_cpus[node]) == 0) return true;   // unknown: no-op
+    return ::sched_setaffinity(0, sizeof(cpu_set_t), &t.node_cpus[node]) == 0;
+}
+
+} // namespace numa
+
+NumaArenaSet::NumaArenaSet(std::size_t block_size) {
+    const unsigned n = numa::node_count();
+    shards_.reserve(n);
+    for (unsigned i = 0; i < n; ++i)
+        shards_.push_back(std::make_unique<Arena>(block_size));
+}
+
+void NumaArenaSet::reset_all() noexcept {
+    for (auto& s : shards_) s->reset();
+}
+
+} // namespace alikhan
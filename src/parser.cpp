@@ -0,0 +1,138 @@
+#include "alikhan/parser.hpp"
+
+#include "alikhan/simd_find.hpp"
+
+namespace alikhan {
+
+namespace {
+
+// Trailing '.' or '-' on a token is sentence punctuation, not part of
+// the term ("skills." -> "skills"); inner occurrences stay ("C++",
+// "name@host.com").
+std::string_view trim_token(std::string_view t) noexcept {
+    while (!t.empty() && (t.back() == '.' || t.back() == '-'))
+        t.remove_suffix(1);
+    return t;
+}
+
+// Single pass over `body`, appending tokens to the section's
+// SmallVec (inline for short sections, arena spill for long ones).
+void scan_tokens(std::string_view body,
+                 SmallVec<std::string_view, Section::kInlineTokens>& out) {
+    std::size_t i = 0;
+    while (i < body.size()) {
+        while (i < body.size() && !is_token_byte(std::uint8_t(body[i]))) ++i;
+        const std::size_t start = i;
+        while (i < body.size() && is_token_byte(std::uint8_t(body[i]))) ++i;
+        if (i == start) break;
+        const std::string_view tok = trim_token(body.substr(start, i - start));
+        if (!tok.empty()) out.push_back(tok);
+    }
+}
+
+// A heading line is "#"+ space + text. Returns the level (0 if the
+// line is not a heading).
+int heading_level(std::string_view line) noexcept {
+    std::size_t h = 0;
+    while (h < line.size() && line[h] == '#') ++h;
+    if (h == 0 || h >= line.size() || line[h] != ' ') return 0;
+    return int(h);
+}
+
+std::string_view heading_text(std::string_view line, int level) noexcept {
+    std::string_view t = line.substr(std::size_t(level) + 1);
+    while (!t.empty() && t.front() == ' ') t.remove_prefix(1);
+    while (!t.empty() && (t.back() == ' ' || t.back() == '\r')) t.remove_suffix(1);
+    return t;
+}
+
+} // namespace
+
+const Document* ResumeParser::parse(std::string_view text) {
+    Document* doc = arena_.create<Document>();
+    doc->text = text;
+
+    // Pass 1: count sections (heading lines + optional preamble).
+    std::size_t nsections = 0;
+    bool preamble = false;
+    {
+        std::size_t pos = 0;
+        bool first_content = true;
+        while (pos < text.size()) {
+            std::size_t eol = find_byte(text.substr(pos), '\n');
+            const std::size_t len =
+                eol == std::string_view::npos ? text.size() - pos : eol;
+            const std::string_view line = text.substr(pos, len);
+            if (heading_level(line) != 0) {
+                ++nsections;
+                first_content = false;
+            } else if (first_content && !line.empty()) {
+                preamble = true;
+                ++nsections;
+                first_content = false;
+            }
+            pos += len + 1;
+        }
+        if (nsections == 0 && !text.empty()) {
+            preamble = true;
+            nsections = 1;
+        }
+    }
+
+    if (nsections == 0) return doc;   // empty input
+
+    Section* sections = static_cast<Section*>(
+        arena_.allocate(nsections * sizeof(Section), alignof(Section)));
+    for (std::size_t s = 0; s < nsections; ++s) {
+        ::new (&sections[s]) Section();
+        sections[s].tokens =
+            SmallVec<std::string_view, Section::kInlineTokens>(arena_);
+    }
+
+    // Pass 2: delimit each section's heading and body.
+    {
+        std::size_t pos = 0;
+        std::size_t cur = 0;           // index of the section being filled
+        std::size_t body_start = 0;
+        bool open = false;
+        if (preamble) {
+            body_start = 0;
+            open = true;
+        }
+        while (pos < text.size()) {
+            std::size_t eol = find_byte(text.substr(pos), '\n');
+            const std::size_t len =
+                eol == std::string_view::npos ? text.size() - pos : eol;
+            const std::string_view line = text.substr(pos, len);
+            const int level = heading_level(line);
+            if (level != 0) {
+                if (open) {
+                    sections[cur].body = text.substr(body_start, pos - body_start);
+                    ++cur;
+                }
+                sections[cur].level = level;
+                sections[cur].heading = heading_text(line, level);
+                body_start = pos + len + (eol == std::string_view::npos ? 0 : 1);
+                open = true;
+            }
+            pos += len + 1;
+        }
+        if (open)
+            sections[cur].body = text.substr(body_start,
+                                             text.size() - body_start);
+    }
+
+    // Pass 3: tokenize each body straight into its SmallVec.
+    std::size_t total_tokens = 0;
+    for (std::size_t s = 0; s < nsections; ++s) {
+        scan_tokens(sections[s].body, sections[s].tokens);
+        total_tokens += sections[s].tokens.size();
+    }
+
+    doc->sections = sections;
+    doc->section_count = nsections;
+    doc->token_count = total_tokens;
+    return doc;
+}
+
+} // namespace alikhan
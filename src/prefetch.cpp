@@ -0,0 +1,53 @@
+#include "alikhan/prefetch.hpp"
+
+#include <algorithm>
+
+namespace alikhan {
+
+PrefetchController::PrefetchController(Options opts) noexcept : opts_(opts) {
+    if (opts_.min_depth == 0) opts_.min_depth = 1;
+    if (opts_.max_depth < opts_.min_depth) opts_.max_depth = opts_.min_depth;
+    depth_ = std::clamp(opts_.initial_depth, opts_.min_depth, opts_.max_depth);
+    if (opts_.min_readahead == 0) opts_.min_readahead = 1;
+    if (opts_.max_readahead < opts_.min_readahead)
+        opts_.max_readahead = opts_.min_readahead;
+    readahead_ = opts_.min_readahead;
+}
+
+void PrefetchController::record(std::uint64_t latency_us) noexcept {
+    // The floor creeps upward by ~0.4% per sample so a device that
+    // genuinely slowed down (volume migration, failed-over path) is
+    // re-learned within a few windows instead of being throttled
+    // against a stale baseline forever.
+    if (floor_us_ == 0 || latency_us < floor_us_)
+        floor_us_ = latency_us;
+    else
+        floor_us_ += floor_us_ / 256 + 1;
+
+    window_[filled_++] = latency_us;
+    if (filled_ == kWindow) {
+        adapt();
+        filled_ = 0;
+    }
+}
+
+void PrefetchController::adapt() noexcept {
+    // p99 of a 64-sample window is the second-worst completion; a
+    // nth_element keeps this O(window), cheap next to the I/O itself.
+    std::nth_element(window_, window_ + (kWindow - 2), window_ + kWindow);
+    const std::uint64_t p99 = window_[kWindow - 2];
+
+    const double limit = double(floor_us_) * opts_.spike;
+    if (floor_us_ != 0 && double(p99) > limit) {
+        // Multiplicative decrease: the queue is where the tail lives.
+        depth_ = std::max(opts_.min_depth, depth_ / 2);
+        readahead_ = std::max(opts_.min_readahead, readahead_ / 2);
+    } else {
+        // Additive increase probes for headroom one slot at a time.
+        depth_ = std::min(opts_.max_depth, depth_ + 1);
+        readahead_ =
+            std::min(opts_.max_readahead, readahead_ + opts_.min_readahead);
+    }
+}
+
+} // namespace alikhan
@@ -0,0 +1,69 @@
+#include "alikhan/probe.hpp"
+
+#include <cstdio>
+
+namespace alikhan {
+
+namespace {
+
+std::atomic<Probe*>& probe_list_head() noexcept {
+    static std::atomic<Probe*> head{nullptr};
+    return head;
+}
+
+} // namespace
+
+Probe::Probe(const char* name) noexcept : name_(name), counts_{} {
+    // Push-front onto the global list; probes are static and never
+    // unregister, so a CAS loop is all the coordination needed.
+    auto& head = probe_list_head();
+    next_ = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(next_, this, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
+}
+
+Probe* Probe::first() noexcept {
+    return probe_list_head().load(std::memory_order_acquire);
+}
+
+std::uint64_t Probe::quantile_ns(double q) const noexcept {
+    const std::uint64_t total = count();
+    if (total == 0) return 0;
+    if (q < 0) q = 0;
+    if (q > 1) q = 1;
+    const std::uint64_t target =
+        std::uint64_t(q * double(total - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (unsigned b = 0; b < kMajor * kMinor; ++b) {
+        seen += counts_[b].load(std::memory_order_relaxed);
+        if (seen >= target) return bucket_floor(b);
+    }
+    return bucket_floor(kMajor * kMinor - 1);
+}
+
+std::uint64_t Probe::max_ns() const noexcept {
+    for (unsigned b = kMajor * kMinor; b-- > 0;)
+        if (counts_[b].load(std::memory_order_relaxed) != 0)
+            return bucket_floor(b);
+    return 0;
+}
+
+bool write_probe_report(const char* path) {
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr) return false;
+    bool ok = true;
+    for (const Probe* p = Probe::first(); p != nullptr; p = p->next()) {
+        if (std::fprintf(f, "%s\t%llu\t%llu\t%llu\t%llu\t%llu\n", p->name(),
+                         (unsigned long long)p->count(),
+                         (unsigned long long)p->quantile_ns(0.50),
+                         (unsigned long long)p->quantile_ns(0.90),
+                         (unsigned long long)p->quantile_ns(0.99),
+                         (unsigned long long)p->max_ns()) < 0)
+            ok = false;
+    }
+    if (std::fclose(f) != 0) ok = false;
+    return ok;
+}
+
+} // namespace alikhan
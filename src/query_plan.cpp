@@ -0,0 +1,118 @@
+#include "alikhan/query_plan.hpp"
+
+#include <algorithm>
+
+namespace alikhan {
+
+namespace {
+
+// Chunk of postings decoded per refill; multiples of four keep the
+// svb pshufb path engaged.
+constexpr std::size_t kDecodeChunk = 256;
+
+} // namespace
+
+QueryPlan::QueryPlan(const InvertedIndex& idx, const std::string_view* terms,
+                     std::size_t count) {
+    if (count == 0) {
+        empty_ = true;
+        return;
+    }
+
+    // Resolve terms and order by selectivity, rarest first.
+    std::vector<std::uint32_t> ids(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ids[i] = idx.find_term(terms[i]);
+        if (ids[i] == InvertedIndex::kNoTerm) {
+            empty_ = true;
+            return;
+        }
+    }
+    std::sort(ids.begin(), ids.end(),
+              [&](std::uint32_t a, std::uint32_t b) {
+                  return idx.doc_count(a) < idx.doc_count(b);
+              });
+
+    // The rarest list drives and is worth decoding eagerly: the
+    // intersection visits all of it anyway.
+    const InvertedIndex::Postings dp = idx.postings(ids[0]);
+    driver_.resize(dp.doc_count);
+    idx.decode_postings(dp, driver_.data());
+
+    others_.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i)
+        others_.emplace_back(idx.postings(ids[i]));
+}
+
+bool QueryPlan::Cursor::seek(std::uint32_t target) {
+    // Decode just far enough that the target is inside the prefix.
+    while (docs.empty() || docs.back() < target) {
+        std::uint32_t chunk[kDecodeChunk];
+        const std::size_t got = dec.decode_next(kDecodeChunk, chunk);
+        if (got == 0) return false;   // exhausted below target
+        std::uint32_t prev = docs.empty() ? 0 : docs.back();
+        const std::size_t base = docs.size();
+        docs.resize(base + got);
+        for (std::size_t i = 0; i < got; ++i) {
+            // First value of the stream is absolute, the rest deltas.
+            prev = (base + i == 0) ? chunk[i] : prev + chunk[i];
+            docs[base + i] = prev;
+        }
+    }
+
+    // Gallop from the previous position; candidates ascend, so the
+    // cursor only moves forward.
+    std::size_t hop = 1;
+    while (pos + hop < docs.size() && docs[pos + hop] < target) hop *= 2;
+    const std::size_t lo = pos + hop / 2;
+    const std::size_t hi = std::min(pos + hop + 1, docs.size());
+    pos = std::size_t(std::lower_bound(docs.begin() + lo, docs.begin() + hi,
+                                       target) -
+                      docs.begin());
+    return pos < docs.size();
+}
+
+bool QueryPlan::next(std::uint32_t& doc) {
+    if (empty_) return false;
+    while (dpos_ < driver_.size()) {
+        const std::uint32_t cand = driver_[dpos_];
+        std::uint32_t resume = cand;
+        bool hit = true;
+        for (Cursor& c : others_) {
+            if (!c.seek(cand)) {
+                dpos_ = driver_.size();   // some list exhausted: done
+                return false;
+            }
+            if (c.current() != cand) {
+                resume = c.current();     // smallest doc that can match
+                hit = false;
+                break;
+            }
+        }
+        if (hit) {
+            doc = cand;
+            ++dpos_;
+            return true;
+        }
+        // Gallop the driver past everything below `resume`.
+        std::size_t hop = 1;
+        while (dpos_ + hop < driver_.size() && driver_[dpos_ + hop] < resume)
+            hop *= 2;
+        dpos_ = std::size_t(std::lower_bound(driver_.begin() + dpos_ + hop / 2,
+                                             driver_.begin() +
+                                                 std::min(dpos_ + hop + 1,
+                                                          driver_.size()),
+                                             resume) -
+                            driver_.begin());
+    }
+    return false;
+}
+
+std::size_t QueryPlan::run(std::uint32_t* out, std::size_t limit) {
+    std::size_t n = 0;
+    std::uint32_t doc;
+    while (n < limit && next(doc)) out[n++] = doc;
+    return n;
+}
+
+} // namespace alikhan
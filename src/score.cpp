@@ -0,0 +1,112 @@
+#include "alikhan/score.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace alikhan {
+
+namespace {
+
+void accumulate_scalar(const float* tf, const float* norm, float idf,
+                       float k1_plus1, float* score, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i)
+        score[i] += idf * (tf[i] * k1_plus1) / (tf[i] + norm[i]);
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2"))) void accumulate_avx2(
+    const float* tf, const float* norm, float idf, float k1_plus1,
+    float* score, std::size_t n) noexcept {
+    const __m256 vidf = _mm256_set1_ps(idf);
+    const __m256 vk1 = _mm256_set1_ps(k1_plus1);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 t = _mm256_load_ps(tf + i);
+        const __m256 m = _mm256_load_ps(norm + i);
+        const __m256 num = _mm256_mul_ps(_mm256_mul_ps(t, vk1), vidf);
+        const __m256 s = _mm256_div_ps(num, _mm256_add_ps(t, m));
+        _mm256_store_ps(score + i, _mm256_add_ps(_mm256_load_ps(score + i), s));
+    }
+    for (; i < n; ++i)
+        score[i] += idf * (tf[i] * k1_plus1) / (tf[i] + norm[i]);
+}
+
+#endif // __x86_64__
+
+using AccumulateFn = void (*)(const float*, const float*, float, float, float*,
+                              std::size_t) noexcept;
+
+AccumulateFn resolve_accumulate() noexcept {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) return accumulate_avx2;
+#endif
+    return accumulate_scalar;
+}
+
+} // namespace
+
+void TopK::push(std::uint32_t doc, float score) {
+    const auto worse = [](const Hit& a, const Hit& b) {
+        return a.score > b.score;   // min-heap on score
+    };
+    if (heap_.size() < k_) {
+        heap_.push_back({doc, score});
+        std::push_heap(heap_.begin(), heap_.end(), worse);
+        return;
+    }
+    if (k_ == 0 || score <= heap_.front().score) return;
+    std::pop_heap(heap_.begin(), heap_.end(), worse);
+    heap_.back() = {doc, score};
+    std::push_heap(heap_.begin(), heap_.end(), worse);
+}
+
+std::vector<TopK::Hit> TopK::take() {
+    std::sort(heap_.begin(), heap_.end(),
+              [](const Hit& a, const Hit& b) { return a.score > b.score; });
+    return std::move(heap_);
+}
+
+std::size_t ScoreBatch::reset(const std::uint32_t* docs, std::size_t n) {
+    count_ = n < kBatch ? n : kBatch;
+    std::memcpy(doc_, docs, count_ * sizeof(std::uint32_t));
+    std::memset(score_, 0, count_ * sizeof(float));
+    return count_;
+}
+
+void ScoreBatch::load_norms(const ColumnView& len_col, const Bm25Params& p) {
+    // Gather is index-bound, not math-bound; the kernel below is
+    // where the lanes pay off.
+    const float inv_avg = 1.0f / p.avg_doc_len;
+    for (std::size_t i = 0; i < count_; ++i) {
+        const float dl = float(len_col.get_u64(doc_[i]));
+        norm_[i] = p.k1 * (1.0f - p.b + p.b * dl * inv_avg);
+    }
+}
+
+void ScoreBatch::load_tf(const ColumnView& freq_col) {
+    if (freq_col.codec() == ColumnCodec::Raw &&
+        freq_col.type() == ColumnType::U32) {
+        const std::uint32_t* raw = freq_col.data<std::uint32_t>();
+        for (std::size_t i = 0; i < count_; ++i)
+            tf_[i] = float(raw[doc_[i]]);
+        return;
+    }
+    for (std::size_t i = 0; i < count_; ++i)
+        tf_[i] = float(freq_col.get_u64(doc_[i]));
+}
+
+void ScoreBatch::accumulate(float idf, const Bm25Params& p) {
+    static const AccumulateFn fn = resolve_accumulate();
+    fn(tf_, norm_, idf, p.k1 + 1.0f, score_, count_);
+}
+
+void ScoreBatch::top_k(TopK& out) const {
+    for (std::size_t i = 0; i < count_; ++i) out.push(doc_[i], score_[i]);
+}
+
+} // namespace alikhan
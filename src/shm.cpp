@@ -0,0 +1,160 @@
+#include "alikhan/shm.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace alikhan {
+
+using shm_detail::SegmentHeader;
+
+namespace {
+
+constexpr char kMagic[4] = {'A', 'K', 'S', 'H'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kPage = 4096;
+
+std::size_t align_page(std::size_t v) noexcept {
+    return (v + kPage - 1) & ~(kPage - 1);
+}
+
+} // namespace
+
+bool ShmSegment::create(const char* name, std::size_t slot_capacity) noexcept {
+    close();
+    const std::size_t slot = align_page(slot_capacity);
+    const std::size_t total = kPage + 2 * slot;
+
+    const int fd = ::shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) return false;
+    if (::ftruncate(fd, off_t(total)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    void* p = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+
+    auto* h = ::new (p) SegmentHeader();
+    std::memcpy(h->magic, kMagic, sizeof(kMagic));
+    h->version = kVersion;
+    h->slot_capacity = slot;
+    h->seq.store(0, std::memory_order_relaxed);
+    h->active_slot = 0;
+    h->active_size = 0;
+    h->epoch = 0;
+
+    header_ = h;
+    slots_[0] = static_cast<char*>(p) + kPage;
+    slots_[1] = slots_[0] + slot;
+    map_size_ = total;
+    writable_ = true;
+    return true;
+}
+
+bool ShmSegment::attach(const char* name) noexcept {
+    close();
+    const int fd = ::shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < kPage) {
+        ::close(fd);
+        errno = EINVAL;
+        return false;
+    }
+    const std::size_t total = std::size_t(st.st_size);
+    void* p = ::mmap(nullptr, total, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+
+    auto* h = static_cast<SegmentHeader*>(p);
+    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 ||
+        h->version != kVersion ||
+        kPage + 2 * h->slot_capacity > total) {
+        ::munmap(p, total);
+        errno = EINVAL;
+        return false;
+    }
+    header_ = h;
+    slots_[0] = static_cast<char*>(p) + kPage;
+    slots_[1] = slots_[0] + h->slot_capacity;
+    map_size_ = total;
+    writable_ = false;
+    return true;
+}
+
+void ShmSegment::close() noexcept {
+    if (header_ != nullptr) ::munmap(header_, map_size_);
+    header_ = nullptr;
+    slots_[0] = slots_[1] = nullptr;
+    map_size_ = 0;
+    writable_ = false;
+}
+
+bool ShmSegment::unlink(const char* name) noexcept {
+    return ::shm_unlink(name) == 0;
+}
+
+std::size_t ShmSegment::slot_capacity() const noexcept {
+    return header_ != nullptr ? std::size_t(header_->slot_capacity) : 0;
+}
+
+bool ShmSegment::publish(const void* data, std::size_t size) noexcept {
+    if (header_ == nullptr || !writable_) {
+        errno = EACCES;
+        return false;
+    }
+    if (size > header_->slot_capacity) {
+        errno = EINVAL;
+        return false;
+    }
+    // Fill the standby slot first; readers only ever follow the
+    // published descriptor, so the copy needs no synchronization.
+    const std::uint64_t standby = header_->active_slot ^ 1u;
+    std::memcpy(slots_[standby], data, size);
+
+    // Tiny seqlock critical section: flip the descriptor.
+    const std::uint64_t s = header_->seq.load(std::memory_order_relaxed);
+    header_->seq.store(s + 1, std::memory_order_release);   // odd: in flux
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->active_slot = standby;
+    header_->active_size = size;
+    header_->epoch += 1;
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->seq.store(s + 2, std::memory_order_release);
+    return true;
+}
+
+bool ShmSegment::read(View& out) const noexcept {
+    if (header_ == nullptr) return false;
+    for (;;) {
+        const std::uint64_t s1 = header_->seq.load(std::memory_order_acquire);
+        if (s1 & 1) continue;                    // writer mid-flip
+        const std::uint64_t slot = header_->active_slot;
+        const std::uint64_t size = header_->active_size;
+        const std::uint64_t epoch = header_->epoch;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header_->seq.load(std::memory_order_relaxed) != s1) continue;
+        if (epoch == 0) return false;            // nothing published yet
+        out.data = slots_[slot];
+        out.size = std::size_t(size);
+        out.epoch = epoch;
+        return true;
+    }
+}
+
+bool ShmSegment::validate(const View& v) const noexcept {
+    return header_ != nullptr && v.epoch != 0 && epoch() <= v.epoch + 1;
+}
+
+std::uint64_t ShmSegment::epoch() const noexcept {
+    if (header_ == nullptr) return 0;
+    View v;
+    return read(v) ? v.epoch : 0;
+}
+
+} // namespace alikhan
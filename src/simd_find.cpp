@@ -0,0 +1,182 @@
+#include "alikhan/simd_find.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace alikhan {
+namespace detail {
+
+std::size_t find_scalar(std::string_view hay, std::string_view needle) noexcept {
+    if (needle.empty()) return 0;
+    if (hay.size() < needle.size()) return std::string_view::npos;
+    const char first = needle[0];
+    const std::size_t last = hay.size() - needle.size();
+    for (std::size_t i = 0; i <= last;) {
+        const void* p = std::memchr(hay.data() + i, first, last - i + 1);
+        if (p == nullptr) return std::string_view::npos;
+        i = std::size_t(static_cast<const char*>(p) - hay.data());
+        if (std::memcmp(hay.data() + i + 1, needle.data() + 1, needle.size() - 1) == 0)
+            return i;
+        ++i;
+    }
+    return std::string_view::npos;
+}
+
+static std::size_t find_first_of_scalar(std::string_view hay,
+                                        std::string_view delims) noexcept {
+    bool table[256] = {};
+    for (unsigned char c : delims) table[c] = true;
+    for (std::size_t i = 0; i < hay.size(); ++i)
+        if (table[static_cast<unsigned char>(hay[i])]) return i;
+    return std::string_view::npos;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+std::size_t find_avx2(std::string_view hay, std::string_view needle) noexcept {
+    if (needle.empty()) return 0;
+    if (hay.size() < needle.size()) return std::string_view::npos;
+    if (needle.size() == 1) return find_byte(hay, needle[0]);
+
+    const __m256i first = _mm256_set1_epi8(needle.front());
+    const __m256i last = _mm256_set1_epi8(needle.back());
+    const char* data = hay.data();
+    const std::size_t n = hay.size() - needle.size() + 1;
+    std::size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        const __m256i block_first =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i block_last = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(data + i + needle.size() - 1));
+        unsigned mask = unsigned(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                             _mm256_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const unsigned bit = unsigned(__builtin_ctz(mask));
+            if (std::memcmp(data + i + bit + 1, needle.data() + 1,
+                            needle.size() - 2) == 0)
+                return i + bit;
+            mask &= mask - 1;
+        }
+    }
+
+    if (i < n) {
+        std::string_view tail(data + i, hay.size() - i);
+        std::size_t r = find_scalar(tail, needle);
+        if (r != std::string_view::npos) return i + r;
+    }
+    return std::string_view::npos;
+}
+
+__attribute__((target("avx2")))
+static std::size_t find_first_of_avx2(std::string_view hay,
+                                      std::string_view delims) noexcept {
+    if (delims.size() > 8)   // broadcast cost exceeds the table scan
+        return find_first_of_scalar(hay, delims);
+    __m256i d[8];
+    for (std::size_t k = 0; k < delims.size(); ++k)
+        d[k] = _mm256_set1_epi8(delims[k]);
+    const char* data = hay.data();
+    std::size_t i = 0;
+    for (; i + 32 <= hay.size(); i += 32) {
+        const __m256i block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hit = _mm256_setzero_si256();
+        for (std::size_t k = 0; k < delims.size(); ++k)
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, d[k]));
+        const unsigned mask = unsigned(_mm256_movemask_epi8(hit));
+        if (mask != 0) return i + unsigned(__builtin_ctz(mask));
+    }
+    if (i < hay.size()) {
+        std::size_t r =
+            find_first_of_scalar({data + i, hay.size() - i}, delims);
+        if (r != std::string_view::npos) return i + r;
+    }
+    return std::string_view::npos;
+}
+
+#elif defined(__aarch64__)
+
+static std::size_t find_neon(std::string_view hay,
+                             std::string_view needle) noexcept {
+    if (needle.empty()) return 0;
+    if (hay.size() < needle.size()) return std::string_view::npos;
+    if (needle.size() == 1) return find_byte(hay, needle[0]);
+
+    const uint8x16_t first = vdupq_n_u8(std::uint8_t(needle.front()));
+    const uint8x16_t last = vdupq_n_u8(std::uint8_t(needle.back()));
+    const auto* data = reinterpret_cast<const std::uint8_t*>(hay.data());
+    const std::size_t n = hay.size() - needle.size() + 1;
+    std::size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16_t eq = vandq_u8(
+            vceqq_u8(vld1q_u8(data + i), first),
+            vceqq_u8(vld1q_u8(data + i + needle.size() - 1), last));
+        // Narrow the 16 lane results to a 64-bit scan mask (4 bits/lane).
+        std::uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        while (mask != 0) {
+            const unsigned bit = unsigned(__builtin_ctzll(mask)) >> 2;
+            if (std::memcmp(data + i + bit + 1, needle.data() + 1,
+                            needle.size() - 2) == 0)
+                return i + bit;
+            mask &= ~(std::uint64_t(0xF) << (bit * 4));
+        }
+    }
+
+    if (i < n) {
+        std::size_t r = find_scalar({hay.data() + i, hay.size() - i}, needle);
+        if (r != std::string_view::npos) return i + r;
+    }
+    return std::string_view::npos;
+}
+
+#endif
+
+using FindFn = std::size_t (*)(std::string_view, std::string_view) noexcept;
+
+static FindFn resolve_find() noexcept {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) return find_avx2;
+#elif defined(__aarch64__)
+    return find_neon;
+#endif
+    return find_scalar;
+}
+
+static FindFn resolve_find_first_of() noexcept {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) return find_first_of_avx2;
+#endif
+    return find_first_of_scalar;
+}
+
+} // namespace detail
+
+std::size_t find(std::string_view hay, std::string_view needle) noexcept {
+    static const detail::FindFn fn = detail::resolve_find();
+    return fn(hay, needle);
+}
+
+std::size_t find_byte(std::string_view hay, char c) noexcept {
+    if (hay.empty()) return std::string_view::npos;
+    const void* p = std::memchr(hay.data(), c, hay.size());
+    return p != nullptr
+               ? std::size_t(static_cast<const char*>(p) - hay.data())
+               : std::string_view::npos;
+}
+
+std::size_t find_first_of(std::string_view hay, std::string_view delims) noexcept {
+    static const detail::FindFn fn = detail::resolve_find_first_of();
+    return fn(hay, delims);
+}
+
+} // namespace alikhan
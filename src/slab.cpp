@@ -0,0 +1,167 @@
+#include "alikhan/slab.hpp"
+
+#include "alikhan/arena.hpp"
+
+#include <atomic>
+#include <new>
+
+namespace alikhan {
+
+namespace {
+
+// Distinguishes operator-new blocks from slab blocks in the header;
+// real bin pointers are always 8-byte aligned.
+constexpr std::uintptr_t kLargeTag = 1;
+
+// Address is unique per thread; comparing it against the value
+// cached in a ThreadCache identifies the owning thread without a
+// thread-id syscall on every free.
+thread_local char tls_marker;
+
+constexpr unsigned class_of(std::size_t chunk) noexcept {
+    unsigned c = 0;
+    std::size_t sz = SlabAlloc::kMinClass;
+    while (sz < chunk) {
+        sz *= 2;
+        ++c;
+    }
+    return c;
+}
+
+constexpr std::size_t class_size(unsigned c) noexcept {
+    return SlabAlloc::kMinClass << c;
+}
+
+struct FreeNode {
+    FreeNode* next;
+};
+
+} // namespace
+
+struct SlabAlloc::ThreadCache {
+    struct ClassBin {
+        ThreadCache* cache = nullptr;
+        FreeNode* local = nullptr;
+        char* bump = nullptr;
+        char* bump_end = nullptr;
+        std::atomic<FreeNode*> remote{nullptr};
+    };
+
+    explicit ThreadCache(const void* key) : arena(64 * 1024), tls_key(key) {
+        for (unsigned c = 0; c < kClasses; ++c) bins[c].cache = this;
+    }
+
+    Arena arena;
+    const void* tls_key;           // &tls_marker of the owning thread
+    ClassBin bins[kClasses];
+};
+
+namespace {
+
+// Per-thread map from allocator to its cache; a thread rarely
+// touches more than a couple of SlabAllocs, so a linear list with
+// move-to-front beats a real map.
+struct TlsLink {
+    const SlabAlloc* alloc;
+    void* cache;               // SlabAlloc::ThreadCache, private there
+};
+thread_local std::vector<TlsLink> tls_links;
+
+} // namespace
+
+SlabAlloc::SlabAlloc() = default;
+
+SlabAlloc::~SlabAlloc() {
+    // Arenas release all slab memory here; callers guarantee no
+    // block outlives the allocator.
+    std::lock_guard<std::mutex> lock(reg_mu_);
+    for (auto& link : tls_links)
+        if (link.alloc == this) link.alloc = nullptr;
+    caches_.clear();
+}
+
+SlabAlloc::ThreadCache& SlabAlloc::local_cache() {
+    for (std::size_t i = 0; i < tls_links.size(); ++i) {
+        if (tls_links[i].alloc == this) {
+            if (i != 0) std::swap(tls_links[0], tls_links[i]);
+            return *static_cast<ThreadCache*>(tls_links[0].cache);
+        }
+    }
+    auto cache = std::make_unique<ThreadCache>(&tls_marker);
+    ThreadCache* raw = cache.get();
+    {
+        std::lock_guard<std::mutex> lock(reg_mu_);
+        caches_.push_back(std::move(cache));
+    }
+    tls_links.push_back({this, raw});
+    return *raw;
+}
+
+void* SlabAlloc::allocate(std::size_t size) {
+    const std::size_t chunk = size + sizeof(void*);
+    if (chunk > kMaxClass) {
+        void* raw = ::operator new(chunk);
+        *static_cast<std::uintptr_t*>(raw) = kLargeTag;
+        return static_cast<char*>(raw) + sizeof(void*);
+    }
+
+    const unsigned c = class_of(chunk);
+    ThreadCache::ClassBin& bin = local_cache().bins[c];
+
+    FreeNode* node = bin.local;
+    if (node == nullptr) {
+        // Absorb whatever other threads freed back to us.
+        node = bin.remote.exchange(nullptr, std::memory_order_acquire);
+    }
+    if (node != nullptr) {
+        bin.local = node->next;
+        // The freelist link clobbered the header; restore it.
+        char* raw = reinterpret_cast<char*>(node);
+        *reinterpret_cast<ThreadCache::ClassBin**>(raw) = &bin;
+        return raw + sizeof(void*);
+    }
+
+    const std::size_t sz = class_size(c);
+    if (bin.bump == bin.bump_end) {
+        // Carve a fresh slab: 32 chunks, capped at one arena block.
+        const std::size_t slab = sz * 32 <= 64 * 1024 ? sz * 32 : sz;
+        bin.bump = static_cast<char*>(
+            bin.cache->arena.allocate(slab, alignof(std::max_align_t)));
+        bin.bump_end = bin.bump + slab;
+    }
+    char* raw = bin.bump;
+    bin.bump += sz;
+    *reinterpret_cast<ThreadCache::ClassBin**>(raw) = &bin;
+    return raw + sizeof(void*);
+}
+
+void SlabAlloc::deallocate(void* p) noexcept {
+    if (p == nullptr) return;
+    char* raw = static_cast<char*>(p) - sizeof(void*);
+    const std::uintptr_t head = *reinterpret_cast<std::uintptr_t*>(raw);
+    if (head == kLargeTag) {
+        ::operator delete(raw);
+        return;
+    }
+    auto* bin = reinterpret_cast<ThreadCache::ClassBin*>(head);
+    auto* node = reinterpret_cast<FreeNode*>(raw);
+    if (bin->cache->tls_key == &tls_marker) {
+        node->next = bin->local;
+        bin->local = node;
+        return;
+    }
+    // Remote free: CAS-push onto the owner's incoming stack.
+    FreeNode* top = bin->remote.load(std::memory_order_relaxed);
+    do {
+        node->next = top;
+    } while (!bin->remote.compare_exchange_weak(top, node,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+SlabAlloc& SlabAlloc::global() {
+    static SlabAlloc instance;
+    return instance;
+}
+
+} // namespace alikhan
@@ -0,0 +1,47 @@
+#include "alikhan/startup_prof.hpp"
+
+#include <cstdio>
+
+namespace alikhan {
+
+namespace {
+
+struct Registry {
+    std::mutex mu;
+    std::vector<StartupRecord> records;
+};
+
+// Function-local static: constructed on first record regardless of
+// which TU's initializer runs first.
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+} // namespace
+
+void record_startup_cost(const char* name, std::uint64_t ns) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    r.records.push_back({name, ns});
+}
+
+std::vector<StartupRecord> startup_records() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    return r.records;
+}
+
+bool write_startup_report(const char* path) {
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr) return false;
+    bool ok = true;
+    for (const auto& rec : startup_records())
+        if (std::fprintf(f, "%s\t%llu\n", rec.name,
+                         (unsigned long long)rec.ns) < 0)
+            ok = false;
+    if (std::fclose(f) != 0) ok = false;
+    return ok;
+}
+
+} // namespace alikhan
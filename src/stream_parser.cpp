@@ -0,0 +1,108 @@
+#include "alikhan/stream_parser.hpp"
+
+#include "alikhan/parser.hpp"
+#include "alikhan/simd_find.hpp"
+
+namespace alikhan {
+
+namespace {
+
+int heading_level_of(std::string_view line) noexcept {
+    std::size_t h = 0;
+    while (h < line.size() && line[h] == '#') ++h;
+    if (h == 0 || h >= line.size() || line[h] != ' ') return 0;
+    return int(h);
+}
+
+std::string_view heading_text_of(std::string_view line, int level) noexcept {
+    std::string_view t = line.substr(std::size_t(level) + 1);
+    while (!t.empty() && t.front() == ' ') t.remove_prefix(1);
+    while (!t.empty() && (t.back() == ' ' || t.back() == '\r')) t.remove_suffix(1);
+    return t;
+}
+
+std::string_view trim_token(std::string_view t) noexcept {
+    while (!t.empty() && (t.back() == '.' || t.back() == '-'))
+        t.remove_suffix(1);
+    return t;
+}
+
+} // namespace
+
+void StreamParser::feed(std::string_view chunk) {
+    chunk_ = chunk;
+}
+
+void StreamParser::finish() {
+    finished_ = true;
+}
+
+bool StreamParser::take_line() {
+    const std::size_t nl = find_byte(chunk_, '\n');
+    if (nl == std::string_view::npos) {
+        // No complete line in what remains; stash it and wait for the
+        // next chunk -- unless input is done, in which case the carry
+        // is the final line.
+        if (!chunk_.empty()) {
+            carry_.append(chunk_);
+            chunk_ = {};
+        }
+        if (!finished_ || carry_.empty()) return false;
+        line_buf_ = std::move(carry_);
+        carry_.clear();
+        line_ = line_buf_;
+    } else if (!carry_.empty()) {
+        carry_.append(chunk_.substr(0, nl));
+        chunk_.remove_prefix(nl + 1);
+        line_buf_ = std::move(carry_);
+        carry_.clear();
+        line_ = line_buf_;
+    } else {
+        line_ = chunk_.substr(0, nl);
+        chunk_.remove_prefix(nl + 1);
+    }
+
+    heading_level_ = heading_level_of(line_);
+    line_is_heading_ = heading_level_ != 0;
+    heading_pending_ = line_is_heading_;
+    return true;
+}
+
+bool StreamParser::next(Event& out) {
+    for (;;) {
+        if (heading_pending_) {
+            heading_pending_ = false;
+            out.type = EventType::SectionStart;
+            out.level = heading_level_;
+            out.text = heading_text_of(line_, heading_level_);
+            line_ = {};   // heading lines contribute no tokens
+            return true;
+        }
+
+        // Emit the next token of the current line.
+        while (!line_.empty()) {
+            std::size_t i = 0;
+            while (i < line_.size() && !is_token_byte(std::uint8_t(line_[i])))
+                ++i;
+            std::size_t j = i;
+            while (j < line_.size() && is_token_byte(std::uint8_t(line_[j])))
+                ++j;
+            const std::string_view tok = trim_token(line_.substr(i, j - i));
+            line_.remove_prefix(j);
+            if (!tok.empty()) {
+                out.type = EventType::Token;
+                out.level = 0;
+                out.text = tok;
+                return true;
+            }
+            if (i == j) {
+                line_ = {};
+                break;
+            }
+        }
+
+        if (!take_line()) return false;
+    }
+}
+
+} // namespace alikhan